@@ -55,11 +55,27 @@
 
 /*
  * Enabling USE_DEFAULT_MULTITHREADING sets all multithreaded features
- * to use their default multithread setting.
+ * to use their default multithread setting. This includes the FFT threads
+ * and the thread pool of USE_PARALLEL_EXECUTION.
  * This may lead to data corruption.
  */
 // #define USE_DEFAULT_MULTITHREADING
 
+/*
+ * Enabling NO_SIMD_KERNELS disables the explicit SSE2/AVX2/AVX-512 kernels
+ * and their runtime CPU dispatching. Every vector operation then runs
+ * the portable scalar loops.
+ */
+// #define NO_SIMD_KERNELS
+
+/*
+ * Enabling USE_PARALLEL_EXECUTION splits element-wise operations on long
+ * vectors over the library-wide thread pool by default, leaving the FFT
+ * threads alone. USE_DEFAULT_MULTITHREADING implies it. It can also be
+ * toggled at runtime with vtool::parallel::set_enabled().
+ */
+// #define USE_PARALLEL_EXECUTION
+
 // -------------------------- compiler statement -------------------------- //
 // gcc options
 #if defined(__GNUC__) && !defined(__clang__)
@@ -143,6 +159,15 @@
 #   endif
 #endif
 
+// Control vector length check
+#ifdef NO_VECTOR_LENGTH_CHECK
+#   define _vtool_length_check(lhv, rhv)
+#   define _vtool_size_check(vec, N)
+#else
+#   define _vtool_length_check(lhv, rhv) if (!vtool::_is_same_length(lhv, rhv)) vtool::throw_vector_length_error(__func__)
+#   define _vtool_size_check(vec, N) if ((vec).size() != (N)) vtool::throw_vector_length_error(__func__)
+#endif
+
 // Control default double
 #ifndef LONG_DOUBLE_AS_DEFAULT
 #   define VTOOL_DBL double
@@ -155,15 +180,24 @@
 #include <vector>
 
 #include "vtool_fft.h"
+#include "vtool_convolve.h"
+#include "vtool_simd.h"
+#include "vtool_view.h"
 #include "vtool_utils.h"
+#include "vtool_stats.h"
+#include "vtool_parallel.h"
 #include "vtool_traits.h"
 #include "vtool_windows.h"
+#include "vtool_expression.h"
 #include "vtool_operator.h"
+#include "vtool_blas.h"
 
 #undef NO_CXX20_VERSION_WARNING
 #undef NO_VECTOR_LENGTH_CHECK
 #undef LONG_DOUBLE_AS_DEFAULT
 #undef USE_DEFAULT_MULTITHREADING
+#undef NO_SIMD_KERNELS
+#undef USE_PARALLEL_EXECUTION
 
 #undef _CXX11_CPLUSPLUS
 #undef _CXX14_CPLUSPLUS
@@ -181,4 +215,7 @@
 #undef _CXX20_CONSTEXPR
 #undef _CXX20_CONSTEVAL
 
+#undef _vtool_length_check
+#undef _vtool_size_check
+
 #endif  // __VECTORTOOLS_H__
\ No newline at end of file
@@ -1,8 +1,10 @@
 #include <cmath>
+#include <cstdint>
 #include <vector>
 #include <complex>
 #include <iomanip>
 #include <iostream>
+#include <stdexcept>
 
 #include "vectortools.h"
 
@@ -38,6 +40,42 @@ test_int{
 static const
 std::size_t win_width = 5;
 
+// +=, -=, *= and /= of 69 elements, twice the widest register (32 int16
+// lanes of avx512) plus a tail, on "set" against the isa::scalar loops
+template <typename T1, typename T2>
+static bool
+simd_matches_scalar(const vtool::simd::isa set)
+{
+    std::vector<T1> lhs(69);
+    std::vector<T2> rhs(69);
+
+    for (std::size_t n = 0; n < lhs.size(); ++n)
+    {
+        lhs[n] = static_cast<T1>(n % 7 + 1);
+        rhs[n] = static_cast<T2>(n % 5 + 1);
+    }
+
+    bool same = true;
+    for (int op = 0; op < 4; ++op)
+    {
+        std::vector<T1> simd_vec(lhs), scalar_vec(lhs);
+
+        for (std::vector<T1>* vec: { &simd_vec, &scalar_vec })
+        {
+            vtool::simd::set_isa(vec == &simd_vec ? set : vtool::simd::isa::scalar);
+            switch (op)
+            {
+                case 0:  *vec += rhs; break;
+                case 1:  *vec -= rhs; break;
+                case 2:  *vec *= rhs; break;
+                default: *vec /= rhs; break;
+            }
+        }
+        same = same && simd_vec == scalar_vec;
+    }
+    return same;
+}
+
 void
 vectortools_test_plan()
 {
@@ -70,6 +108,71 @@ vectortools_test_plan()
         << "  " << vtool::irfft(forward_r2c_dbl)   << "\n"
         << "  " << vtool::irfft(forward_r2c_cmplx) << "\n\n";
 
+    const vtool::rfft_plan<double> test_plan(test_dbl.size());
+    std::vector<std::complex<double>> test_plan_bins(test_dbl.size()/2+1);
+    std::vector<double> test_plan_back(test_dbl.size());
+
+    test_plan.execute(test_dbl, test_plan_bins);
+    test_plan.execute(test_plan_bins, test_plan_back);
+
+    const vtool::fft_cache::info test_cache = vtool::fft_cache::stats();
+
+    std::cout
+        << "| rfft_plan, fft_cache |\n"
+        << "  forward:  " << test_plan_bins << "\n"
+        << "  backward: " << test_plan_back << "\n"
+        << "  cache:    " << test_cache.entries << " plans, "
+        << test_cache.hits << " hits, " << test_cache.misses << " misses\n\n";
+
+    std::vector<std::complex<long double>> test_inplace(test_cmplx);
+    const std::complex<long double>* const test_inplace_buf = test_inplace.data();
+
+    vtool::fft_inplace(test_inplace);
+    vtool::ifft_inplace(test_inplace);
+
+    std::cout
+        << "| fft_inplace, ifft_inplace |\n"
+        << "  " << test_inplace
+        << " (same buffer: " << (test_inplace.data() == test_inplace_buf) << ")\n\n";
+
+    bool test_partial_frame = false;
+    try { vtool::rfft_batch(test_dbl, 4); }
+    catch (const std::length_error&) { test_partial_frame = true; }
+
+    std::cout
+        << "| rfft_batch (2 frames of 3 samples) |\n"
+        << "  " << vtool::rfft_batch(test_dbl, 3) << "\n"
+        << "  frames of 4 rejected: " << test_partial_frame << "\n\n";
+
+    std::cout
+        << "| fft_threads |\n"
+        << "  default:                 " << vtool::fft_threads::num_threads() << "\n"
+        << "  automatic(2^26):         " << vtool::fft_threads::automatic(std::size_t(1) << 26) << "\n"
+        << "  rfft_batch on 2 threads: " << vtool::rfft_batch(test_dbl, 3, 2) << "\n\n";
+
+    const std::vector<std::complex<double>> test_stft
+        = vtool::stft(test_dbl, 4, 2, vtool::windows::type::rectangular);
+
+    std::cout
+        << "| stft, istft (frames of 4 samples, hop 2) |\n"
+        << "  stft:  " << test_stft << "\n"
+        << "  istft: " << vtool::istft(test_stft, 4, 2, vtool::windows::type::rectangular) << "\n\n";
+
+    const std::vector<double> test_kernel{ 1.0, 0.5, 0.25 };
+    vtool::overlap_save<double> test_filter(test_kernel, 4);
+
+    std::cout
+        << "| convolve, correlate, overlap_save |\n"
+        << "  convolve:     " << vtool::convolve(test_dbl, test_kernel)    << "\n"
+        << "  fftconvolve:  " << vtool::fftconvolve(test_dbl, test_kernel) << "\n"
+        << "  correlate:    " << vtool::correlate(test_dbl, test_kernel)   << "\n"
+        << "  overlap_save: " << test_filter.process(test_dbl)             << "\n\n";
+
+    std::cout
+        << "| welch, periodogram |\n"
+        << "  welch:       " << vtool::welch(test_dbl, 4, 2)    << "\n"
+        << "  periodogram: " << vtool::periodogram(test_dbl)    << "\n\n";
+
     std::cout
         << "──────────────────────────────────────────────────"
         << "──────────────────────────────────────────────────" << "\n\n";
@@ -103,6 +206,86 @@ vectortools_test_plan()
         << "  (int)3 / vector<double>:      " << 3 / test_dbl        << "\n"
         << "  vector<double> / vector<int>: " << test_dbl / test_int << "\n\n";
 
+    const std::vector<double> test_chain = test_dbl * test_int + 3 - test_dbl / 2;
+
+    std::cout
+        << "| expression chain |\n"
+        << "  vector<double> * vector<int> + 3 - vector<double> / 2: " << test_chain << "\n"
+        << "  eval(vector<int> + vector<int>):                        " << vtool::eval(test_int + test_int) << "\n\n";
+
+    std::cout
+        << "| rvalue operands |\n"
+        << "  vector_cast<double>(vector<int>) * vector<double>: " << vtool::vector_cast<double>(test_int) * test_dbl << "\n"
+        << "  10 - vector_cast<double>(vector<int>):            " << 10 - vtool::vector_cast<double>(test_int) << "\n\n";
+
+    // the expiring vector<int> is moved into the expression kept in "auto"
+    const auto test_kept = std::vector<int>(test_int) + 0.5;
+    const std::vector<double> test_kept_vec = test_kept;
+    const auto test_nested = test_kept * test_dbl - test_dbl;
+    const std::vector<double> test_nested_vec = test_nested;
+
+    std::cout
+        << "| expression of a temporary kept in auto |\n"
+        << "  vector<int>(...) + 0.5:                 " << test_kept_vec   << "\n"
+        << "  kept * vector<double> - vector<double>: " << test_nested_vec << "\n\n";
+
+    std::cout
+        << "| simd kernels against isa::scalar (" << vtool::simd::isa_name(vtool::simd::detected_isa()) << " detected) |\n";
+
+    for (int set = 1; set <= static_cast<int>(vtool::simd::detected_isa()); ++set)
+    {
+        const vtool::simd::isa isa = static_cast<vtool::simd::isa>(set);
+
+        std::cout
+            << "  " << std::setw(6) << vtool::simd::isa_name(isa) << ": "
+            << "float "  << simd_matches_scalar<float, float>(isa)
+            << " double " << simd_matches_scalar<double, double>(isa)
+            << " int16 "  << simd_matches_scalar<std::int16_t, std::int16_t>(isa)
+            << " int32 "  << simd_matches_scalar<std::int32_t, std::int32_t>(isa)
+            << " float/int16 "  << simd_matches_scalar<float, std::int16_t>(isa)
+            << " double/float " << simd_matches_scalar<double, float>(isa)
+            << " int32/float "  << simd_matches_scalar<std::int32_t, float>(isa) << "\n";
+    }
+    vtool::simd::set_isa(vtool::simd::detected_isa());
+    std::cout << "\n";
+
+    const std::vector<double> half_int = 0.5 * vtool::vector_cast<double>(test_int);
+    std::vector<double> test_axpy(half_int), test_scale_add(half_int), test_fma(half_int);
+
+    vtool::axpy(2, half_int, test_axpy);
+    vtool::scale_add(test_scale_add, -1, half_int);
+    vtool::fma(half_int, half_int, test_fma);
+
+    const std::vector<float> tenths(100003, 0.1f), ones(100003, 1.0f);
+    const VTOOL_DBL tenths_exact = 100003 * static_cast<VTOOL_DBL>(0.1f);
+
+    std::cout
+        << "| fused kernels (y = 0.5 * vector<int>) |\n"
+        << "  axpy(2, y, y):       " << test_axpy      << "\n"
+        << "  scale_add(y, -1, y): " << test_scale_add << "\n"
+        << "  fma(y, y, y):        " << test_fma       << "\n"
+        << "  dot(y, vector<int>): " << vtool::dot(half_int, test_int) << "\n"
+        << "  dot of 100003 float 0.1f, in double lanes: "
+        << (std::fabs(vtool::dot(tenths, ones) - tenths_exact) < 1e-9 * tenths_exact) << "\n\n";
+
+    const std::vector<double> serial_chain = test_dbl * test_int + test_dbl;
+
+    vtool::parallel::set_enabled(true);
+    vtool::parallel::set_threshold(2);
+    const std::vector<double> parallel_chain = test_dbl * test_int + test_dbl;
+    const std::vector<int> parallel_bools = vtool::vector_cast<int>(std::vector<bool>{true, false, true});
+    vtool::parallel::set_threshold(0);
+    const VTOOL_DBL parallel_empty = vtool::sum(std::vector<double>());
+    vtool::parallel::set_threshold(vtool::parallel::parallel_c::threshold);
+    vtool::parallel::set_enabled(vtool::parallel::parallel_c::enabled);
+
+    std::cout
+        << "| parallel execution (" << vtool::parallel::num_threads() << " threads) |\n"
+        << "  vector<double> * vector<int> + vector<double>: " << parallel_chain << "\n"
+        << "  same as serial reference:                      " << (parallel_chain == serial_chain) << "\n"
+        << "  vector_cast<int>(vector<bool>):                " << parallel_bools << "\n"
+        << "  sum of an empty vector, threshold 0:           " << parallel_empty << "\n\n";
+
     std::cout
         << "──────────────────────────────────────────────────"
         << "──────────────────────────────────────────────────" << "\n\n";
@@ -120,6 +303,27 @@ vectortools_test_plan()
         << "  endpoint = true:  " << vtool::linspace(0, 14, 7, true)  << "\n"
         << "  endpoint = false: " << vtool::linspace(0, 14, 7, false) << "\n\n";
 
+    std::cout
+        << "| arange(), logspace(), geomspace(), generator ranges |\n"
+        << "  arange(5):                         " << vtool::arange(5)                  << "\n"
+        << "  arange(1.0, 2.0, 0.25):            " << vtool::arange(1.0, 2.0, 0.25)    << "\n"
+        << "  logspace(0, 3, 4):                 " << vtool::logspace(0, 3, 4)          << "\n"
+        << "  geomspace(-1, -8, 4):              " << vtool::geomspace(-1, -8, 4)       << "\n"
+        << "  linspace_range(0, 14, 7) * 2 + 1:  " << vtool::eval(vtool::linspace_range(0, 14, 7) * 2 + 1) << "\n"
+        << "  sum(arange_range(1, 101)):         " << vtool::sum(vtool::arange_range(1, 101)) << "\n"
+        << "  max(geomspace_range(1, 1000, 4)):  " << vtool::max(vtool::geomspace_range(1, 1000, 4)) << "\n\n";
+
+    const std::vector<float> pcm_flt{-1.5f, -1.0f, -0.25f, 0.0f, 0.5f, 1.0f, 2.0f};
+    const std::vector<std::int16_t> pcm16 = vtool::vector_cast<std::int16_t>(pcm_flt, 32767, vtool::conversion::saturate);
+    const std::vector<vtool::int24_t> pcm24 = vtool::vector_cast<vtool::int24_t>(pcm_flt, 8388607, vtool::conversion::saturate);
+
+    std::cout
+        << "| vector_cast(vec, scale, conversion policy) |\n"
+        << "  float -> int16, saturate:   " << pcm16 << "\n"
+        << "  int16 -> float / 32768:     " << vtool::vector_cast<float>(pcm16, 1.0/32768, vtool::conversion::truncate) << "\n"
+        << "  float -> int24 -> float:    " << vtool::vector_cast<float>(pcm24, 1.0/8388607, vtool::conversion::truncate) << "\n"
+        << "  {-1.5, 2.5, 3.5}, round:    " << vtool::vector_cast<int>(std::vector<double>{-1.5, 2.5, 3.5}, vtool::conversion::round) << "\n\n";
+
     std::cout
         << "| mean() |\n"
         << "  {-1, 0, 1}: " << vtool::mean(std::vector<int>{-1, 0, 1})    << "\n"
@@ -146,6 +350,104 @@ vectortools_test_plan()
         << "  min:    " << vtool::min(intvec)    << "\t\t" << vtool::min(dblvec)         << "\n"
         << "  median: " << vtool::median(intvec) << "\t\t" << vtool::median(dblvec)      << "\n\n";
 
+    std::vector<double> test_ramp(100000);
+    for (std::size_t n = 0; n < test_ramp.size(); ++n)
+        test_ramp[n] = 0.1 * static_cast<double>(n % 1000) - 50.0;
+
+    vtool::parallel::set_enabled(true);
+    vtool::parallel::set_threshold(2);
+    vtool::parallel::set_num_threads(1);
+    const VTOOL_DBL test_sum_1 = vtool::sum(test_ramp);
+    vtool::parallel::set_num_threads(4);
+    const VTOOL_DBL test_sum_4 = vtool::sum(test_ramp);
+    const VTOOL_DBL test_rms_4 = vtool::rms(test_ramp);
+    const double test_max_4 = vtool::max(test_ramp);
+    vtool::parallel::set_num_threads(0);
+    vtool::parallel::set_threshold(vtool::parallel::parallel_c::threshold);
+    vtool::parallel::set_enabled(vtool::parallel::parallel_c::enabled);
+
+    const std::vector<bool> test_bools{true, false, true, true};
+
+    std::cout
+        << "| parallel reductions (100000 elements) |\n"
+        << "  sum, 1 vs 4 threads: " << test_sum_1 << ", " << test_sum_4
+        << " (identical: " << (test_sum_1 == test_sum_4) << ")\n"
+        << "  rms, max:            " << test_rms_4 << ", " << test_max_4 << "\n"
+        << "  vector<bool>{1, 0, 1, 1} sum, max, min: " << vtool::sum(test_bools) << ", "
+        << vtool::max(test_bools) << ", " << vtool::min(test_bools) << "\n\n";
+
+    auto test_latency = std::vector<double>{12.0, 7.0, 3.0, 25.0, 9.0, 4.0, 18.0, 5.0, 31.0, 6.0};
+
+    bool test_empty_median = false;
+    try { vtool::median(std::vector<double>()); }
+    catch (const std::length_error&) { test_empty_median = true; }
+
+    std::cout
+        << "| quantile, quantiles |\n"
+        << "  {12, 7, 3, 25, 9, 4, 18, 5, 31, 6}\n"
+        << "  quantile(0.25):                " << vtool::quantile(test_latency, 0.25) << "\n"
+        << "  quantiles(0.5, 0.9, 0.99):     " << vtool::quantiles(test_latency, {0.5, 0.9, 0.99}) << "\n"
+        << "  quantiles_inplace(0.5, 0.999): " << vtool::quantiles_inplace(test_latency, {0.5, 0.999}) << "\n"
+        << "  median of empty rejected:      " << test_empty_median << "\n\n";
+
+    const auto test_stats = vtool::describe(test_dbl);
+    const auto test_subset = vtool::describe<vtool::stat::mean | vtool::stat::argmax>(dblvec);
+
+    std::cout
+        << "| describe() |\n"
+        << "  vector<double>:  count " << test_stats.count << ", sum " << test_stats.sum
+        << ", mean " << test_stats.mean << ", variance " << test_stats.variance << "\n"
+        << "                   rms " << test_stats.rms << ", norm " << test_stats.norm
+        << ", min " << test_stats.min << " at " << test_stats.argmin
+        << ", max " << test_stats.max << " at " << test_stats.argmax << "\n"
+        << "  <mean | argmax>: mean " << test_subset.mean << ", argmax " << test_subset.argmax
+        << ", sum (not selected) " << test_subset.sum << "\n\n";
+
+    vtool::accumulator<double> test_acc, test_acc_other;
+    vtool::quantile_sketch test_sketch;
+
+    test_acc.push(vtool::make_view(test_dbl).subview(0, 3));
+    test_acc_other.push(vtool::make_view(test_dbl).subview(3, test_dbl.size() - 3));
+    test_acc.merge(test_acc_other);
+
+    for (int n = 1; n <= 1000; ++n)
+        test_sketch.push(n);
+
+    bool test_sketch_nan = false;
+    try { test_sketch.push(std::nan("")); }
+    catch (const std::domain_error&) { test_sketch_nan = true; }
+
+    std::cout
+        << "| accumulator, quantile_sketch |\n"
+        << "  2 chunks merged:  count " << test_acc.count() << ", mean " << test_acc.mean()
+        << ", variance " << test_acc.variance() << ", rms " << test_acc.rms()
+        << ", min " << test_acc.min() << ", max " << test_acc.max() << "\n"
+        << "  1..1000 (±1%):    p50 " << test_sketch.quantile(0.5) << ", p90 " << test_sketch.quantile(0.9)
+        << ", p99 " << test_sketch.quantile(0.99) << "\n"
+        << "  NaN rejected:     " << test_sketch_nan << "\n\n";
+
+    vtool::rolling<vtool::stat::max, int> test_roll(3);
+    std::vector<int> test_roll_max;
+    test_roll.push(std::vector<int>{1, 2, 3, 4}, test_roll_max);
+    test_roll.push(std::vector<int>{5, 6}, test_roll_max);
+
+    std::cout
+        << "| rolling_mean, rolling_median, rolling<stat::max> (window 3) |\n"
+        << "  {1.1 ... 6.6}, step 1:       " << vtool::rolling_mean(test_dbl, 3)      << "\n"
+        << "  {1, 10, 100, -1, 0}, step 2: " << vtool::rolling_median(std::vector<int>{1, 10, 100, -1, 0}, 3, 2) << "\n"
+        << "  chunks {1, 2, 3, 4} {5, 6}:  " << test_roll_max << "\n\n";
+
+    const std::vector<double> test_cancel{1e16, 1.0, -1e16};
+
+    std::cout
+        << "| summation policies |\n"
+        << "  {1e16, 1.0, -1e16}:  serial "   << vtool::sum(test_cancel, vtool::summation::serial)
+        << ", lanes "    << vtool::sum(test_cancel, vtool::summation::lanes)
+        << ", pairwise " << vtool::sum(test_cancel, vtool::summation::pairwise)
+        << ", kahan "    << vtool::sum(test_cancel, vtool::summation::kahan) << "\n"
+        << "  rms(vector<double>): " << vtool::rms(test_dbl, vtool::summation::kahan)
+        << ", mean(view) "           << vtool::mean(vtool::make_view(dblvec), vtool::summation::pairwise) << "\n\n";
+
     std::cout
         << "| abs() |\n"
         << "  {1, 2, 3}:            " << vtool::abs(std::vector<int>{1, 2, 3})                                                    << "\n"
@@ -163,15 +465,60 @@ vectortools_test_plan()
         << "  +3×{1, 2, 3}:        " << vtool::duplicate_append(std::vector<int>{1, 2, 3}, 3)          << "\n"
         << "  +0×{1.0, 2.0, 3.0}:  " << vtool::duplicate_append(std::vector<double>{1.0, 2.0, 3.0}, 0) << "\n\n";
 
+    std::cout
+        << "| tile(), repeat() |\n"
+        << "  tile({1, 2, 3}, 2):           " << vtool::tile(std::vector<int>{1, 2, 3}, 2)   << "\n"
+        << "  repeat({1, 2, 3}, 2):         " << vtool::repeat(std::vector<int>{1, 2, 3}, 2) << "\n"
+        << "  repeat({1, 2, 3}, {0, 1, 3}): " << vtool::repeat(std::vector<int>{1, 2, 3}, std::vector<std::size_t>{0, 1, 3}) << "\n\n";
+
     const auto test_il0 = std::vector<int>{1, 2, 3, 1, 2, 3, 1, 2, 3};
     const auto test_il1 = vtool::interleave(test_il0, 3);
     const auto test_il2 = vtool::interleave(test_il1, 3);
 
+    const auto test_view = vtool::make_view(test_dbl).subview(1, 3, 2);
+    std::vector<double> test_view_out(test_dbl);
+
+    vtool::make_view(test_view_out).subview(0, 3, 2) += test_view;
+
+    bool test_stride0 = false;
+    try { test_view.subview(0, 3, 0); }
+    catch (const std::domain_error&) { test_stride0 = true; }
+
+    bool test_past_end = false;
+    try { test_view.subview(1, 3); }
+    catch (const std::out_of_range&) { test_past_end = true; }
+
+    const std::vector<std::int8_t> test_int8(200, 1);
+
+    std::cout
+        << "| view (every 2nd element from index 1) |\n"
+        << "  view of vector<double>:  " << test_view                  << "\n"
+        << "  sum(), max():            " << vtool::sum(test_view) << "\t" << vtool::max(test_view) << "\n"
+        << "  view * 2 + 1:            " << vtool::eval(test_view * 2 + 1) << "\n"
+        << "  rfft(view):              " << vtool::rfft(test_view)     << "\n"
+        << "  even elements += view:   " << test_view_out              << "\n"
+        << "  step 0 rejected:         " << test_stride0               << "\n"
+        << "  past the end rejected:   " << test_past_end              << "\n"
+        << "  mean, rms of 200 int8 1: " << vtool::mean(vtool::make_view(test_int8))
+        << "\t" << vtool::rms(vtool::make_view(test_int8)) << "\n\n";
+
     std::cout
         << "| interleave() |\n"
         << "  before interleaved:  " << test_il0 << "\n"
         << "  1st interleaving:    " << test_il1 << "\n"
-        << "  2nd interleaving:    " << test_il2 << "\n\n";
+        << "  2nd interleaving:    " << test_il2 << "\n"
+        << "  vector<bool>{1, 0, 1, 1} in 2: " << vtool::interleave(std::vector<bool>{true, false, true, true}, 2) << "\n\n";
+
+    const auto test_frames = std::vector<float>{1, 10, 2, 20, 3, 30, 4, 40};
+    std::vector<std::vector<float>> test_channels(2);
+    vtool::interleave_into(test_frames, test_channels);
+
+    std::cout
+        << "| interleave(), deinterleave() for 2 channels |\n"
+        << "  frames:                 " << test_frames                              << "\n"
+        << "  interleave(frames, 2):  " << vtool::interleave(test_frames, 2)        << "\n"
+        << "  per-channel buffers:    " << test_channels[0] << "| " << test_channels[1] << "\n"
+        << "  deinterleave(channels): " << vtool::deinterleave(test_channels)       << "\n\n";
 
     const auto test_apply0 = std::vector<double>{0, 1, 2, 3};
     const auto test_apply1 = vtool::apply(test_apply0, (double (*)(double))std::exp);
@@ -181,6 +528,29 @@ vectortools_test_plan()
         << "  before applied: " << test_apply0 << "\n"
         << "  after applied:  " << test_apply1 << "\n\n";
 
+    std::vector<double> test_block_in{-1.0, 3.0, -6.0, 10.0}, test_block_out;
+    test_block_out.reserve(test_block_in.size());
+    const double* const test_block_buf = test_block_out.data();
+
+    vtool::abs_into(test_block_in, test_block_out);
+    vtool::differential_inplace(test_block_out);
+    vtool::apply_inplace(test_block_out, [](const double value){ return value * 10; });
+
+    std::cout
+        << "| abs_into, differential_inplace, apply_inplace |\n"
+        << "  {-1, 3, -6, 10} -> " << test_block_out
+        << " (same buffer: " << (test_block_out.data() == test_block_buf) << ")\n\n";
+
+    const std::vector<double> test_scan{3.0, -1.0, 4.0, -1.0, 5.0};
+
+    std::cout
+        << "| cumsum, cumprod, cummax, cummin |\n"
+        << "  input:   " << test_scan                       << "\n"
+        << "  cumsum:  " << vtool::cumsum(test_scan)        << "\n"
+        << "  cumprod: " << vtool::cumprod(test_scan)       << "\n"
+        << "  cummax:  " << vtool::cummax(test_scan)        << "\n"
+        << "  cummin:  " << vtool::cummin(test_scan)        << "\n\n";
+
     std::cout
         << "──────────────────────────────────────────────────"
         << "──────────────────────────────────────────────────" << "\n\n";
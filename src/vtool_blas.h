@@ -0,0 +1,242 @@
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o ------------------------------------- o
+    Fused BLAS-1 Kernels for std::vector
+  o ------------------------------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VTOOL_BLAS_H__
+#define __VTOOL_BLAS_H__
+
+#include <vector>
+#include <cstddef>
+#include <type_traits>
+
+#include "vtool_simd.h"
+#include "vtool_utils.h"
+#include "vtool_parallel.h"
+#include "vtool_traits.h"
+#include "vtool_expression.h"
+
+/*
+ * Every kernel updates its output vector in a single pass without allocating.
+ * Mixed value types run the generic loops, same-typed float and double
+ * vectors run the dispatched SIMD kernels of the active instruction set.
+ */
+
+namespace vtool {
+
+// --------------------------------- axpy --------------------------------- //
+/* Syntax: vtool::axpy(arithmetic_type a, std::vector x, std::vector y);
+ * Return: Reference to "y" updated to a*x + y.
+ */
+template <typename S, typename T1, typename T2, typename Alloc1, typename Alloc2,
+          typename vtool::is_arithmetic<S, T1, T2>::type = true>
+std::vector<T2, Alloc2>&
+axpy(const S a, const std::vector<T1, Alloc1>& x, std::vector<T2, Alloc2>& y)
+{
+    _vtool_length_check(x, y);
+
+    const T1* const xd = x.data();
+    T2* const yd = y.data();
+
+    vtool::parallel::for_each_range(y.size(), sizeof(T2),
+        [=](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n) yd[n] = a*xd[n] + yd[n];
+        });
+    return y;
+}
+
+template <typename S, typename T, typename Alloc1, typename Alloc2,
+          typename vtool::is_arithmetic<S>::type = true,
+          typename vtool::simd::is_blas_kernel<T>::type = true>
+std::vector<T, Alloc2>&
+axpy(const S a, const std::vector<T, Alloc1>& x, std::vector<T, Alloc2>& y)
+{
+    _vtool_length_check(x, y);
+
+    void (*kernel)(T, const T*, T*, std::size_t)
+        = vtool::simd::_active_blas_kernels<T>().axpy;
+    const T ta = static_cast<T>(a);
+    const T* const xd = x.data();
+    T* const yd = y.data();
+
+    vtool::parallel::for_each_range(y.size(), sizeof(T),
+        [=](const std::size_t begin, const std::size_t end){
+            kernel(ta, xd + begin, yd + begin, end - begin);
+        });
+    return y;
+}
+
+// -------------------------------- axpby --------------------------------- //
+/* Syntax: vtool::axpby(arithmetic_type a, std::vector x, arithmetic_type b, std::vector y);
+ * Return: Reference to "y" updated to a*x + b*y.
+ */
+template <typename S1, typename S2, typename T1, typename T2,
+          typename Alloc1, typename Alloc2,
+          typename vtool::is_arithmetic<S1, S2, T1, T2>::type = true>
+std::vector<T2, Alloc2>&
+axpby(const S1 a, const std::vector<T1, Alloc1>& x,
+      const S2 b, std::vector<T2, Alloc2>& y)
+{
+    _vtool_length_check(x, y);
+
+    const T1* const xd = x.data();
+    T2* const yd = y.data();
+
+    vtool::parallel::for_each_range(y.size(), sizeof(T2),
+        [=](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n) yd[n] = a*xd[n] + b*yd[n];
+        });
+    return y;
+}
+
+template <typename S1, typename S2, typename T, typename Alloc1, typename Alloc2,
+          typename vtool::is_arithmetic<S1, S2>::type = true,
+          typename vtool::simd::is_blas_kernel<T>::type = true>
+std::vector<T, Alloc2>&
+axpby(const S1 a, const std::vector<T, Alloc1>& x,
+      const S2 b, std::vector<T, Alloc2>& y)
+{
+    _vtool_length_check(x, y);
+
+    void (*kernel)(T, const T*, T, T*, std::size_t)
+        = vtool::simd::_active_blas_kernels<T>().axpby;
+    const T ta = static_cast<T>(a);
+    const T tb = static_cast<T>(b);
+    const T* const xd = x.data();
+    T* const yd = y.data();
+
+    vtool::parallel::for_each_range(y.size(), sizeof(T),
+        [=](const std::size_t begin, const std::size_t end){
+            kernel(ta, xd + begin, tb, yd + begin, end - begin);
+        });
+    return y;
+}
+
+// --------------------------------- fma ---------------------------------- //
+/* Syntax: vtool::fma(std::vector a, std::vector b, std::vector c);
+ * Return: Reference to "c" updated to a*b + c element-wise.
+ */
+template <typename T1, typename T2, typename T3,
+          typename Alloc1, typename Alloc2, typename Alloc3,
+          typename vtool::is_arithmetic<T1, T2, T3>::type = true>
+std::vector<T3, Alloc3>&
+fma(const std::vector<T1, Alloc1>& a, const std::vector<T2, Alloc2>& b,
+    std::vector<T3, Alloc3>& c)
+{
+    _vtool_length_check(a, b);
+    _vtool_length_check(a, c);
+
+    const T1* const ad = a.data();
+    const T2* const bd = b.data();
+    T3* const cd = c.data();
+
+    vtool::parallel::for_each_range(c.size(), sizeof(T3),
+        [=](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n) cd[n] = ad[n]*bd[n] + cd[n];
+        });
+    return c;
+}
+
+template <typename T, typename Alloc1, typename Alloc2, typename Alloc3,
+          typename vtool::simd::is_blas_kernel<T>::type = true>
+std::vector<T, Alloc3>&
+fma(const std::vector<T, Alloc1>& a, const std::vector<T, Alloc2>& b,
+    std::vector<T, Alloc3>& c)
+{
+    _vtool_length_check(a, b);
+    _vtool_length_check(a, c);
+
+    void (*kernel)(const T*, const T*, T*, std::size_t)
+        = vtool::simd::_active_blas_kernels<T>().fma;
+    const T* const ad = a.data();
+    const T* const bd = b.data();
+    T* const cd = c.data();
+
+    vtool::parallel::for_each_range(c.size(), sizeof(T),
+        [=](const std::size_t begin, const std::size_t end){
+            kernel(ad + begin, bd + begin, cd + begin, end - begin);
+        });
+    return c;
+}
+
+// ------------------------------ scale_add ------------------------------- //
+/* Syntax: vtool::scale_add(std::vector y, arithmetic_type a, std::vector x);
+ * Return: Reference to "y" updated to a*y + x.
+ */
+template <typename S, typename T1, typename T2, typename Alloc1, typename Alloc2,
+          typename vtool::is_arithmetic<S, T1, T2>::type = true>
+std::vector<T1, Alloc1>&
+scale_add(std::vector<T1, Alloc1>& y, const S a, const std::vector<T2, Alloc2>& x)
+{
+    _vtool_length_check(y, x);
+
+    T1* const yd = y.data();
+    const T2* const xd = x.data();
+
+    vtool::parallel::for_each_range(y.size(), sizeof(T1),
+        [=](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n) yd[n] = a*yd[n] + xd[n];
+        });
+    return y;
+}
+
+template <typename S, typename T, typename Alloc1, typename Alloc2,
+          typename vtool::is_arithmetic<S>::type = true,
+          typename vtool::simd::is_blas_kernel<T>::type = true>
+std::vector<T, Alloc1>&
+scale_add(std::vector<T, Alloc1>& y, const S a, const std::vector<T, Alloc2>& x)
+{
+    _vtool_length_check(y, x);
+
+    void (*kernel)(T*, T, const T*, std::size_t)
+        = vtool::simd::_active_blas_kernels<T>().scale_add;
+    const T ta = static_cast<T>(a);
+    T* const yd = y.data();
+    const T* const xd = x.data();
+
+    vtool::parallel::for_each_range(y.size(), sizeof(T),
+        [=](const std::size_t begin, const std::size_t end){
+            kernel(yd + begin, ta, xd + begin, end - begin);
+        });
+    return y;
+}
+
+// --------------------------------- dot ---------------------------------- //
+/* Syntax: vtool::dot(std::vector x, std::vector y);
+ * Return: Inner product of "x" and "y". Float vectors accumulate
+ *         in double precision lanes.
+ */
+template <typename T1, typename T2, typename Alloc1, typename Alloc2,
+          typename vtool::is_arithmetic<T1, T2>::type = true>
+_CXX20_CONSTEXPR
+VTOOL_DBL
+dot(const std::vector<T1, Alloc1>& x, const std::vector<T2, Alloc2>& y)
+{
+    _vtool_length_check(x, y);
+
+    VTOOL_DBL DOT = 0;
+
+    for (std::size_t n = 0; n < x.size(); ++n)
+        DOT += static_cast<VTOOL_DBL>(x[n]) * static_cast<VTOOL_DBL>(y[n]);
+
+    return DOT;
+}
+
+template <typename T, typename Alloc1, typename Alloc2,
+          typename vtool::simd::is_blas_kernel<T>::type = true>
+inline VTOOL_DBL
+dot(const std::vector<T, Alloc1>& x, const std::vector<T, Alloc2>& y)
+{
+    _vtool_length_check(x, y);
+
+    return static_cast<VTOOL_DBL>(
+        vtool::simd::_active_blas_kernels<T>().dot(x.data(), y.data(), x.size())
+    );
+}
+
+}   // namespace vtool
+
+#endif  // __VTOOL_BLAS_H__
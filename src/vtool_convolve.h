@@ -0,0 +1,437 @@
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o ------------------------------------------- o
+    Convolution and Correlation for std::vector
+  o ------------------------------------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VTOOL_CONVOLVE_H__
+#define __VTOOL_CONVOLVE_H__
+
+#include <vector>
+#include <complex>
+#include <cstddef>
+#include <utility>
+#include <stdexcept>
+#include <functional>
+#include <type_traits>
+#include <algorithm>
+
+#include "vtool_fft.h"
+#include "vtool_view.h"
+#include "vtool_traits.h"
+#include "vtool_parallel.h"
+
+namespace vtool {
+
+namespace conv_c {
+
+    // vtool::convolve() convolves directly while the shorter input has at
+    // most this many points, and through the FFT above
+    static const std::size_t
+    direct_size = 64;
+
+    // overlap-save blocks are about this many times the kernel length
+    static const std::size_t
+    block_factor = 4;
+
+    // smallest overlap-save block
+    static const std::size_t
+    min_block = 256;
+}   // namespace conv_c
+
+// part of the full convolution returned, as in numpy.convolve
+enum class conv_mode: unsigned
+{
+    full,       // every point of overlap, N+M-1 points
+    same,       // centered, max(N, M) points
+    valid       // complete overlap only, max(N, M)-min(N, M)+1 points
+};
+
+// floating point type of the convolution of "T" and "U"
+template <typename T, typename U>
+using _conv_real_t = typename std::conditional<
+    std::is_floating_point<typename std::common_type<T, U>::type>::value,
+    typename std::common_type<T, U>::type, VTOOL_DBL
+>::type;
+
+/* Syntax: vtool::_fft_good_size(std::size_t N);
+ * Return: Smallest length >= N with no prime factor above 5.
+ */
+inline std::size_t
+_fft_good_size(const std::size_t N)
+{
+    if (N <= 6)
+        return N;
+
+    std::size_t best = 2*N;
+    for (std::size_t f5 = 1; f5 < best; f5 *= 5)
+        for (std::size_t f35 = f5; f35 < best; f35 *= 3)
+        {
+            std::size_t f = f35;
+            while (f < N) f *= 2;
+            best = std::min(best, f);
+        }
+    return best;
+}
+
+// offset and length of "mode" within the full convolution of N and M points
+inline std::pair<std::size_t, std::size_t>
+_conv_bounds(const std::size_t N, const std::size_t M, const conv_mode mode)
+{
+    if (N == 0 || M == 0)
+        throw std::invalid_argument("Invalid Convolution: inputs must not be empty");
+
+    const std::size_t shorter = std::min(N, M);
+    const std::size_t longer = std::max(N, M);
+
+    switch (mode)
+    {
+        case conv_mode::full:  return std::make_pair(std::size_t(0), N + M - 1);
+        case conv_mode::same:  return std::make_pair((shorter - 1) / 2, longer);
+        case conv_mode::valid: return std::make_pair(shorter - 1, longer - shorter + 1);
+        default:
+            throw std::invalid_argument("Invalid Convolution: unknown mode");
+    }
+}
+
+// ---------------------------- overlap_save<T> --------------------------- //
+/*
+ * Streaming FIR filter of a fixed kernel by overlap-save. The spectrum of
+ * the kernel and the FFT plan are computed once, and every block of up to
+ * block() new samples costs one forward and one inverse real FFT of nfft()
+ * points against the last taps()-1 samples kept from earlier blocks. Each
+ * output sample is produced as soon as its input is pushed, so chunks of
+ * any size return the same samples as filtering the whole signal at once.
+ */
+template <typename T>
+class overlap_save
+{
+    rfft_plan<T> _plan;
+    std::vector<std::complex<T>> _kernel;   // nfft/2+1 bins of the kernel
+    std::vector<std::complex<T>> _work;     // transform buffer of process()
+    std::vector<T> _history;                // last taps-1 samples pushed
+    std::size_t _taps;
+
+  public:
+    using value_type = T;
+
+    /* "nfft" 0 picks a block of about conv_c::block_factor kernel lengths */
+    template <typename U>
+    explicit
+    overlap_save(const view<U> kernel, const std::size_t nfft=0)
+        : _plan(nfft ? nfft : vtool::_fft_good_size(std::max(
+                    conv_c::min_block, conv_c::block_factor * kernel.size())), 1),
+          _kernel(_plan.size()/2+1), _work(_plan.size()/2+1),
+          _history(kernel.size() ? kernel.size() - 1 : 0, 0), _taps(kernel.size())
+    {
+        if (_taps == 0)
+            throw std::invalid_argument("Invalid Kernel: kernel must not be empty");
+        if (_plan.size() < _taps)
+            throw std::invalid_argument("Invalid FFT Size: nfft is shorter than the kernel");
+
+        T* const buf = reinterpret_cast<T*>(_kernel.data());
+        for (std::size_t n = 0; n < _plan.size(); ++n)
+            buf[n] = n < _taps ? static_cast<T>(kernel[n]) : static_cast<T>(0);
+
+        _plan.execute(view<const T>(buf, _plan.size()), vtool::make_view(_kernel));
+    }
+
+    template <typename U, typename Alloc>
+    explicit
+    overlap_save(const std::vector<U, Alloc>& kernel, const std::size_t nfft=0)
+        : overlap_save(vtool::make_view(kernel), nfft) {}
+
+    inline std::size_t
+    taps() const { return _taps; }
+
+    inline std::size_t
+    nfft() const { return _plan.size(); }
+
+    inline std::size_t
+    block() const { return _plan.size() - _taps + 1; }
+
+    /* Syntax: filter._segment(Fn sample, std::size_t count, vtool::view out,
+     *                         std::complex<T>* work);
+     * Return: None. Stores to the "count" <= block() points of "out" the
+     *         filtered samples sample(taps-1) to sample(taps-2+count), where
+     *         sample(0) to sample(taps-2) are the samples before them.
+     *         "work" holds nfft/2+1 points of scratch.
+     */
+    template <typename Fn>
+    void
+    _segment(const Fn& sample, const std::size_t count, const view<T> out,
+             std::complex<T>* const work) const
+    {
+        const std::size_t nfft = _plan.size();
+        const std::size_t nBin = nfft/2+1;
+        T* const buf = reinterpret_cast<T*>(work);
+
+        for (std::size_t n = 0; n < _taps - 1 + count; ++n)
+            buf[n] = sample(n);
+        std::fill(buf + _taps - 1 + count, buf + nfft, static_cast<T>(0));
+
+        _plan.execute(view<const T>(buf, nfft), view<std::complex<T>>(work, nBin));
+        for (std::size_t k = 0; k < nBin; ++k)
+            work[k] *= _kernel[k];
+        _plan.execute(view<const std::complex<T>>(work, nBin), view<T>(buf, nfft));
+
+        // the first taps-1 points wrapped around the block and are dropped
+        for (std::size_t n = 0; n < count; ++n)
+            out[n] = buf[_taps - 1 + n];
+    }
+
+    /* Syntax: filter.process(vtool::view in, vtool::view out);
+     * Return: "out" holding the next in.size() filtered samples.
+     */
+    template <typename U>
+    view<T>
+    process(const view<U> in, const view<T> out)
+    {
+        _vtool_length_check(in, out);
+        const std::size_t H = _taps - 1;
+
+        for (std::size_t pos = 0; pos < in.size(); pos += this->block())
+        {
+            const std::size_t count = std::min(this->block(), in.size() - pos);
+            const view<U> seg = in.subview(pos, count);
+
+            this->_segment([&](const std::size_t n){
+                return n < H ? _history[n] : static_cast<T>(seg[n - H]);
+            }, count, out.subview(pos, count), _work.data());
+
+            // keeps the last taps-1 samples of the history followed by "seg"
+            if (count >= H)
+                for (std::size_t n = 0; n < H; ++n)
+                    _history[n] = static_cast<T>(seg[count - H + n]);
+            else
+            {
+                std::copy(_history.begin() + count, _history.end(), _history.begin());
+                for (std::size_t n = 0; n < count; ++n)
+                    _history[H - count + n] = static_cast<T>(seg[n]);
+            }
+        }
+        return out;
+    }
+
+    /* Syntax: filter.process(std::vector chunk);
+     * Return: std::vector holding the next chunk.size() filtered samples.
+     */
+    template <typename U, typename Alloc>
+    std::vector<T>
+    process(const std::vector<U, Alloc>& chunk)
+    {
+        std::vector<T> out_vec(chunk.size(), 0);
+        this->process(vtool::make_view(chunk), vtool::make_view(out_vec));
+
+        return out_vec;
+    }
+
+    void
+    reset() { std::fill(_history.begin(), _history.end(), static_cast<T>(0)); }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o -------------------------- o
+    Convolution of vtool::view
+  o -------------------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Every method computes "out.size()" points of the full convolution from
+ * point "first" on, so the modes only differ in the range requested.
+ */
+
+// sum over the overlapping points, the "count" points are split over threads
+template <typename R, typename T, typename U>
+void
+_convolve_direct(const view<T> a, const view<U> b, const view<R> out, const std::size_t first)
+{
+    const std::size_t N = a.size();
+    const std::size_t M = b.size();
+
+    vtool::parallel::for_each_range(out.size(), M * sizeof(R),
+        [&](const std::size_t begin, const std::size_t end){
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                const std::size_t n = first + i;
+                const std::size_t k1 = std::min(n, M - 1);
+                R sum = 0;
+
+                for (std::size_t k = n >= N ? n - N + 1 : 0; k <= k1; ++k)
+                    sum += static_cast<R>(a[n - k]) * static_cast<R>(b[k]);
+                out[i] = sum;
+            }
+        });
+}
+
+// product of the spectra of both inputs zero-padded to one FFT length
+template <typename R, typename T, typename U>
+void
+_convolve_fft(const view<T> a, const view<U> b, const view<R> out, const std::size_t first)
+{
+    const std::size_t nfft = vtool::_fft_good_size(a.size() + b.size() - 1);
+    const std::size_t nBin = nfft/2+1;
+    const rfft_plan<R> plan(nfft);
+
+    std::vector<std::complex<R>> a_bins(nBin);
+    std::vector<std::complex<R>> b_bins(nBin);
+    R* const a_buf = reinterpret_cast<R*>(a_bins.data());
+    R* const b_buf = reinterpret_cast<R*>(b_bins.data());
+
+    for (std::size_t n = 0; n < nfft; ++n)
+    {
+        a_buf[n] = n < a.size() ? static_cast<R>(a[n]) : static_cast<R>(0);
+        b_buf[n] = n < b.size() ? static_cast<R>(b[n]) : static_cast<R>(0);
+    }
+    plan.execute(view<const R>(a_buf, nfft), vtool::make_view(a_bins));
+    plan.execute(view<const R>(b_buf, nfft), vtool::make_view(b_bins));
+
+    for (std::size_t k = 0; k < nBin; ++k)
+        a_bins[k] *= b_bins[k];
+    plan.execute(view<const std::complex<R>>(a_bins), view<R>(a_buf, nfft));
+
+    for (std::size_t i = 0; i < out.size(); ++i)
+        out[i] = a_buf[first + i];
+}
+
+// the long "x" is filtered by the short "h" in overlap-save blocks spread
+// over threads, each block reading the samples before it from "x" itself
+template <typename R, typename T, typename U>
+void
+_convolve_blocks(const view<T> x, const view<U> h, const view<R> out, const std::size_t first)
+{
+    const overlap_save<R> filter(h);
+    const std::size_t N = x.size();
+    const std::size_t H = filter.taps() - 1;
+    const std::size_t S = filter.block();
+    const std::size_t nBlock = (out.size() + S - 1) / S;
+
+    const auto run = [&](const std::size_t b0, const std::size_t b1){
+        std::vector<std::complex<R>> work(filter.nfft()/2+1);
+
+        for (std::size_t b = b0; b < b1; ++b)
+        {
+            const std::size_t pos = b * S;
+            const std::size_t count = std::min(S, out.size() - pos);
+            // sample(0) is x[first + pos - H], zero outside of "x"
+            const std::size_t start = first + pos;
+
+            filter._segment([&](const std::size_t n){
+                return start + n >= H && start + n - H < N
+                     ? static_cast<R>(x[start + n - H]) : static_cast<R>(0);
+            }, count, out.subview(pos, count), work.data());
+        }
+    };
+
+    if (!vtool::parallel::is_parallel(out.size()))
+    {
+        run(0, nBlock);
+        return;
+    }
+
+    const std::size_t nTask = std::min(nBlock, vtool::parallel::num_threads());
+    vtool::parallel::pool()->run(nTask, [&](const std::size_t t){
+        run(nBlock * t / nTask, nBlock * (t+1) / nTask);
+    });
+}
+
+// FFT path: one transform of both inputs, or overlap-save blocks of the
+// shorter one when the longer is many kernel lengths long
+template <typename R, typename T, typename U>
+void
+_convolve_spectral(const view<T> a, const view<U> b, const view<R> out, const std::size_t first)
+{
+    if (a.size() > 2 * conv_c::block_factor * b.size())
+        vtool::_convolve_blocks(a, b, out, first);
+    else if (b.size() > 2 * conv_c::block_factor * a.size())
+        vtool::_convolve_blocks(b, a, out, first);
+    else
+        vtool::_convolve_fft(a, b, out, first);
+}
+
+// ------------------------------ vtool::view ----------------------------- //
+/* Syntax: vtool::convolve(vtool::view a, vtool::view b, vtool::conv_mode mode=full);
+ * Return: std::vector holding the discrete linear convolution of "a" and "b"
+ *         restricted to "mode", like numpy.convolve. Inputs whose shorter one
+ *         has at most conv_c::direct_size points are convolved directly,
+ *         longer ones through the FFT like vtool::fftconvolve().
+ */
+template <typename T, typename U>
+std::vector<_conv_real_t<typename std::remove_cv<T>::type, typename std::remove_cv<U>::type>>
+convolve(const view<T> a, const view<U> b, const conv_mode mode=conv_mode::full)
+{
+    using R = _conv_real_t<typename std::remove_cv<T>::type, typename std::remove_cv<U>::type>;
+
+    const std::pair<std::size_t, std::size_t> bounds
+        = vtool::_conv_bounds(a.size(), b.size(), mode);
+    std::vector<R> conv_vec(bounds.second, 0);
+
+    if (std::min(a.size(), b.size()) <= conv_c::direct_size)
+        vtool::_convolve_direct(a, b, vtool::make_view(conv_vec), bounds.first);
+    else
+        vtool::_convolve_spectral(a, b, vtool::make_view(conv_vec), bounds.first);
+
+    return conv_vec;
+}
+
+/* Syntax: vtool::fftconvolve(vtool::view a, vtool::view b, vtool::conv_mode mode=full);
+ * Return: std::vector holding the convolution of "a" and "b" restricted to
+ *         "mode", always computed through the FFT. An input many times
+ *         longer than the other is filtered in overlap-save blocks, which
+ *         costs O(N log M) instead of O(N log N).
+ */
+template <typename T, typename U>
+std::vector<_conv_real_t<typename std::remove_cv<T>::type, typename std::remove_cv<U>::type>>
+fftconvolve(const view<T> a, const view<U> b, const conv_mode mode=conv_mode::full)
+{
+    using R = _conv_real_t<typename std::remove_cv<T>::type, typename std::remove_cv<U>::type>;
+
+    const std::pair<std::size_t, std::size_t> bounds
+        = vtool::_conv_bounds(a.size(), b.size(), mode);
+    std::vector<R> conv_vec(bounds.second, 0);
+
+    vtool::_convolve_spectral(a, b, vtool::make_view(conv_vec), bounds.first);
+    return conv_vec;
+}
+
+/* Syntax: vtool::correlate(vtool::view a, vtool::view v, vtool::conv_mode mode=valid);
+ * Return: std::vector holding the cross-correlation of "a" and "v" restricted
+ *         to "mode", like numpy.correlate. It is the convolution of "a" with
+ *         "v" read backwards through a negative stride.
+ */
+template <typename T, typename U>
+std::vector<_conv_real_t<typename std::remove_cv<T>::type, typename std::remove_cv<U>::type>>
+correlate(const view<T> a, const view<U> v, const conv_mode mode=conv_mode::valid)
+{
+    const view<U> reversed = v.empty() ? v : v.subview(v.size() - 1, v.size(), -1);
+    return vtool::convolve(a, reversed, mode);
+}
+
+// ------------------------------ std::vector ----------------------------- //
+#define _CONVOLVE_FUNCTION(_name, _mode)                                    \
+template <typename T, typename U, typename AllocT, typename AllocU>         \
+inline std::vector<_conv_real_t<T, U>>                                      \
+_name(const std::vector<T, AllocT>& a, const std::vector<U, AllocU>& b,     \
+      const conv_mode mode=_mode)                                           \
+{                                                                           \
+    return vtool::_name(vtool::make_view(a), vtool::make_view(b), mode);    \
+}
+
+/* Syntax: vtool::convolve(std::vector a, std::vector b, vtool::conv_mode mode=full);
+ *         vtool::fftconvolve (same arguments);
+ *         vtool::correlate(std::vector a, std::vector v, vtool::conv_mode mode=valid);
+ * Return: Same as the vtool::view versions above.
+ */
+_CONVOLVE_FUNCTION(convolve,    conv_mode::full)
+_CONVOLVE_FUNCTION(fftconvolve, conv_mode::full)
+_CONVOLVE_FUNCTION(correlate,   conv_mode::valid)
+
+#undef _CONVOLVE_FUNCTION
+
+}   // namespace vtool
+
+#endif  // __VTOOL_CONVOLVE_H__
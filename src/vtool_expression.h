@@ -0,0 +1,1038 @@
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o ----------------------------------------- o
+    Lazy Expression Templates for std::vector
+  o ----------------------------------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VTOOL_EXPRESSION_H__
+#define __VTOOL_EXPRESSION_H__
+
+#include <cmath>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <functional>
+#include <type_traits>
+
+#include "vtool_simd.h"
+#include "vtool_view.h"
+#include "vtool_traits.h"
+#include "vtool_parallel.h"
+
+namespace vtool {
+
+template <typename E>
+class expression_iterator;
+
+/* Syntax: vtool::_evaluate<std::vector>(expression expr);
+ * Return: std::vector holding every element of "expr", computed in one pass.
+ *         Long expressions are split over the shared thread pool.
+ */
+template <typename V, typename E>
+V
+_evaluate(const E& expr)
+{
+    using T = typename V::value_type;
+    const std::size_t N = expr.size();
+
+    if (!vtool::parallel::is_parallel(N))
+        return V(expr.begin(), expr.end());
+
+    // std::vector value-initialises what it allocates, so one chunk per
+    // thread is evaluated into uninitialised scratch and appended in order,
+    // and every element of the result is written once
+    const std::size_t chunk = std::max<std::size_t>(
+        vtool::parallel::parallel_c::chunk_bytes / sizeof(T), 1
+    );
+    const std::size_t round = chunk * vtool::parallel::num_threads();
+    const std::unique_ptr<T[]> scratch(new T[std::min(round, N)]);
+    T* const buf = scratch.get();
+
+    V eval_vec;
+    eval_vec.reserve(N);
+
+    for (std::size_t first = 0; first < N; first += round)
+    {
+        const std::size_t count = std::min(round, N - first);
+
+        vtool::parallel::pool()->run((count + chunk - 1) / chunk,
+            [&](const std::size_t block){
+                const std::size_t end = std::min((block + 1) * chunk, count);
+                for (std::size_t n = block * chunk; n < end; ++n) buf[n] = expr[first + n];
+            });
+        eval_vec.insert(eval_vec.end(), buf, buf + count);
+    }
+    return eval_vec;
+}
+
+template <typename T>
+class arithmetic_range;
+
+template <typename T>
+class geometric_range;
+
+// generator ranges are filled by the ramp kernel instead of element-wise
+template <typename V, typename T>
+V
+_evaluate(const arithmetic_range<T>& range);
+
+template <typename V, typename T>
+V
+_evaluate(const geometric_range<T>& range);
+
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o ---------------- o
+    Expression Nodes
+  o ---------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+// ------------------------- vector_expression<E> ------------------------- //
+/*
+ * Base of every lazy vector expression. A derived node provides value_type,
+ * allocator_type, size() and operator[]; nothing is computed until the
+ * expression is assigned to a std::vector or evaluated by vtool::eval().
+ */
+template <typename E>
+struct vector_expression
+{
+    _CXX20_CONSTEXPR
+    inline const E&
+    derived() const
+    { return static_cast<const E&>(*this); }
+
+    _CXX20_CONSTEXPR
+    inline expression_iterator<E>
+    begin() const
+    { return expression_iterator<E>(derived(), 0); }
+
+    _CXX20_CONSTEXPR
+    inline expression_iterator<E>
+    end() const
+    { return expression_iterator<E>(derived(), derived().size()); }
+
+    // evaluates the whole expression in a single pass
+    template <typename T, typename Alloc, typename D = E,
+              typename std::enable_if<
+                  std::is_same<T, typename D::value_type>::value, bool
+              >::type = true>
+    operator std::vector<T, Alloc>() const
+    { return vtool::_evaluate<std::vector<T, Alloc>>(derived()); }
+};
+
+// ------------------------- _vector_operand<...> ------------------------- //
+template <typename T, typename Alloc>
+class _vector_operand: public vector_expression<_vector_operand<T, Alloc>>
+{
+    const std::vector<T, Alloc>& _vec;
+
+  public:
+    using value_type     = T;
+    using allocator_type = Alloc;
+
+    _CXX20_CONSTEXPR
+    explicit _vector_operand(const std::vector<T, Alloc>& vec): _vec(vec) {}
+
+    _CXX20_CONSTEXPR
+    inline std::size_t
+    size() const
+    { return _vec.size(); }
+
+    _CXX20_CONSTEXPR
+    inline T
+    operator[](const std::size_t n) const
+    { return _vec[n]; }
+};
+
+// -------------------------- _vector_value<...> ------------------------- //
+// an expiring std::vector moved into the expression, which then owns it;
+// copies of the expression share the buffer instead of duplicating it
+template <typename T, typename Alloc>
+class _vector_value: public vector_expression<_vector_value<T, Alloc>>
+{
+    std::shared_ptr<const std::vector<T, Alloc>> _vec;
+    const T* _data;
+    std::size_t _size;
+
+  public:
+    using value_type     = T;
+    using allocator_type = Alloc;
+
+    explicit _vector_value(std::vector<T, Alloc>&& vec)
+        : _vec(std::make_shared<const std::vector<T, Alloc>>(std::move(vec))),
+          _data(_vec->data()), _size(_vec->size()) {}
+
+    inline std::size_t
+    size() const
+    { return _size; }
+
+    inline T
+    operator[](const std::size_t n) const
+    { return _data[n]; }
+};
+
+// ------------------------- _scalar_operand<...> ------------------------- //
+template <typename T>
+class _scalar_operand
+{
+    const T _value;
+
+  public:
+    using value_type = T;
+
+    _CXX20_CONSTEXPR
+    explicit _scalar_operand(const T value): _value(value) {}
+
+    _CXX20_CONSTEXPR
+    inline T
+    operator[](const std::size_t) const
+    { return _value; }
+};
+
+// ------------------------- expression operations ------------------------ //
+// kernel() is the dispatched compound kernel of the same operation
+template <typename T>
+using _compound_kernel_t = void (*)(T*, const T*, std::size_t);
+
+struct _plus
+{
+    template <typename T>
+    static constexpr T
+    apply(const T lhs, const T rhs)
+    { return lhs + rhs; }
+
+    template <typename T>
+    static inline _compound_kernel_t<T>
+    kernel()
+    { return vtool::simd::_active_kernels<T>().add; }
+};
+
+struct _minus
+{
+    template <typename T>
+    static constexpr T
+    apply(const T lhs, const T rhs)
+    { return lhs - rhs; }
+
+    template <typename T>
+    static inline _compound_kernel_t<T>
+    kernel()
+    { return vtool::simd::_active_kernels<T>().sub; }
+};
+
+struct _multiplies
+{
+    template <typename T>
+    static constexpr T
+    apply(const T lhs, const T rhs)
+    { return lhs * rhs; }
+
+    template <typename T>
+    static inline _compound_kernel_t<T>
+    kernel()
+    { return vtool::simd::_active_kernels<T>().mul; }
+};
+
+struct _divides
+{
+    template <typename T>
+    static constexpr T
+    apply(const T lhs, const T rhs)
+    { return lhs / rhs; }
+
+    template <typename T>
+    static inline _compound_kernel_t<T>
+    kernel()
+    { return vtool::simd::_active_kernels<T>().div; }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o ----------------- o
+    Expression Traits
+  o ----------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+// -------------------------- is_expression<...> -------------------------- //
+template <typename E>
+struct _is_expression: std::is_base_of<vector_expression<E>, E> {};
+
+template <typename... Es>
+struct is_expression: std::enable_if<
+    combination<_is_expression<Es>...>::value, bool
+> {};
+
+// ------------------------ _expression_operand<X> ------------------------ //
+/*
+ * Maps an operator argument onto the node stored inside an expression.
+ * "sized" is false only for scalars, which broadcast over the other operand.
+ */
+template <typename X, typename = void>
+struct _expression_operand
+{
+    static constexpr bool valid = false;
+    static constexpr bool sized = false;
+};
+
+template <typename T, typename Alloc>
+struct _expression_operand<std::vector<T, Alloc>,
+                           typename std::enable_if<std::is_arithmetic<T>::value>::type>
+{
+    static constexpr bool valid = true;
+    static constexpr bool sized = true;
+
+    using type = _vector_operand<T, Alloc>;
+
+    static _CXX20_CONSTEXPR type
+    wrap(const std::vector<T, Alloc>& vec)
+    { return type(vec); }
+};
+
+// "L" of binary_expression is std::vector&& for an operand to be moved in
+template <typename T, typename Alloc>
+struct _expression_operand<std::vector<T, Alloc>&&,
+                           typename std::enable_if<std::is_arithmetic<T>::value>::type>
+{
+    static constexpr bool valid = true;
+    static constexpr bool sized = true;
+
+    using type = _vector_value<T, Alloc>;
+
+    static _CXX20_CONSTEXPR type
+    wrap(std::vector<T, Alloc>& vec)
+    { return type(std::move(vec)); }
+};
+
+template <typename T>
+struct _expression_operand<view<T>,
+                           typename std::enable_if<
+                               std::is_arithmetic<typename view<T>::value_type>::value
+                           >::type>
+{
+    static constexpr bool valid = true;
+    static constexpr bool sized = true;
+
+    using type = view<const typename view<T>::value_type>;
+
+    static _CXX20_CONSTEXPR type
+    wrap(const view<T>& vw)
+    { return type(vw); }
+};
+
+template <typename T>
+struct _expression_operand<T,
+                           typename std::enable_if<std::is_arithmetic<T>::value>::type>
+{
+    static constexpr bool valid = true;
+    static constexpr bool sized = false;
+
+    using type = _scalar_operand<T>;
+
+    static _CXX20_CONSTEXPR type
+    wrap(const T value)
+    { return type(value); }
+};
+
+template <typename E>
+struct _expression_operand<E,
+                           typename std::enable_if<_is_expression<E>::value>::type>
+{
+    static constexpr bool valid = true;
+    static constexpr bool sized = true;
+
+    using type = E;
+
+    static _CXX20_CONSTEXPR const E&
+    wrap(const E& expr)
+    { return expr; }
+
+    static _CXX20_CONSTEXPR E&&
+    wrap(E&& expr)
+    { return std::move(expr); }
+};
+
+// --------------------- is_expression_operands<L, R> --------------------- //
+template <typename L, typename R>
+struct _is_expression_operands: std::integral_constant<bool,
+    _expression_operand<L>::valid && _expression_operand<R>::valid
+    && (_expression_operand<L>::sized || _expression_operand<R>::sized)
+> {};
+
+template <typename L, typename R>
+struct is_expression_operands: std::enable_if<
+    _is_expression_operands<L, R>::value, bool
+> {};
+
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o ----------------- o
+    Binary Expression
+  o ----------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+// ---------------------- binary_expression<Op, L, R> --------------------- //
+template <typename Op, typename L, typename R>
+class binary_expression: public vector_expression<binary_expression<Op, L, R>>
+{
+    using _lhv_t = typename _expression_operand<L>::type;
+    using _rhv_t = typename _expression_operand<R>::type;
+    using _sized_t = typename std::conditional<
+        _expression_operand<L>::sized, _lhv_t, _rhv_t
+    >::type;
+
+    _lhv_t _lhv;
+    _rhv_t _rhv;
+    std::size_t _size;
+
+    static _CXX20_CONSTEXPR std::size_t
+    _operand_size(const _lhv_t& lhv, const _rhv_t&, std::true_type)
+    { return lhv.size(); }
+
+    static _CXX20_CONSTEXPR std::size_t
+    _operand_size(const _lhv_t&, const _rhv_t& rhv, std::false_type)
+    { return rhv.size(); }
+
+  public:
+    using value_type
+        = typename std::common_type<typename _lhv_t::value_type,
+                                    typename _rhv_t::value_type>::type;
+    using allocator_type
+        = rebinded_alloc<typename _sized_t::allocator_type, value_type>;
+
+    // expiring expression operands are moved in, lvalues are copied
+    template <typename LA, typename RA>
+    _CXX20_CONSTEXPR
+    binary_expression(LA&& lhv, RA&& rhv)
+        : _lhv(_expression_operand<L>::wrap(std::forward<LA>(lhv))),
+          _rhv(_expression_operand<R>::wrap(std::forward<RA>(rhv))),
+          _size(_operand_size(_lhv, _rhv, std::integral_constant<
+              bool, _expression_operand<L>::sized
+          >()))
+    {}
+
+    _CXX20_CONSTEXPR
+    inline std::size_t
+    size() const
+    { return _size; }
+
+    _CXX20_CONSTEXPR
+    inline value_type
+    operator[](const std::size_t n) const
+    {
+        return Op::template apply<value_type>(static_cast<value_type>(_lhv[n]),
+                                              static_cast<value_type>(_rhv[n]));
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o ---------------- o
+    Generator Ranges
+  o ---------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Random access ranges computing every point from its index alone. They are
+ * expression terminals, so operators and reductions consume them without a
+ * buffer, and assigning one to a std::vector runs the dispatched ramp kernel.
+ */
+
+// -------------------------- arithmetic_range<T> ------------------------- //
+/*
+ * "num" points start + step*n, the lazy form of linspace and arange.
+ */
+template <typename T>
+class arithmetic_range: public vector_expression<arithmetic_range<T>>
+{
+    T _start;
+    T _step;
+    std::size_t _num;
+
+  public:
+    using value_type     = T;
+    using allocator_type = std::allocator<T>;
+
+    _CXX20_CONSTEXPR
+    arithmetic_range(const T start, const T step, const std::size_t num)
+        : _start(start), _step(step), _num(num) {}
+
+    _CXX20_CONSTEXPR inline std::size_t
+    size() const { return _num; }
+
+    _CXX20_CONSTEXPR inline T
+    start() const { return _start; }
+
+    _CXX20_CONSTEXPR inline T
+    step() const { return _step; }
+
+    _CXX20_CONSTEXPR inline T
+    operator[](const std::size_t n) const
+    { return _start + _step*static_cast<T>(n); }
+};
+
+// -------------------------- geometric_range<T> -------------------------- //
+/*
+ * "num" points scale * base^(start + step*n), the lazy form of logspace and
+ * geomspace.
+ */
+template <typename T>
+class geometric_range: public vector_expression<geometric_range<T>>
+{
+    T _scale;
+    T _base;
+    arithmetic_range<T> _exponent;
+
+  public:
+    using value_type     = T;
+    using allocator_type = std::allocator<T>;
+
+    _CXX20_CONSTEXPR
+    geometric_range(const T scale, const T base, const arithmetic_range<T>& exponent)
+        : _scale(scale), _base(base), _exponent(exponent) {}
+
+    _CXX20_CONSTEXPR inline std::size_t
+    size() const { return _exponent.size(); }
+
+    _CXX20_CONSTEXPR inline T
+    scale() const { return _scale; }
+
+    _CXX20_CONSTEXPR inline T
+    base() const { return _base; }
+
+    _CXX20_CONSTEXPR inline const arithmetic_range<T>&
+    exponent() const { return _exponent; }
+
+    inline T
+    operator[](const std::size_t n) const
+    { return _scale * std::pow(_base, _exponent[n]); }
+};
+
+/* Syntax: vtool::_ramp(arithmetic_type start, arithmetic_type step, pointer data, std::size_t N);
+ * Return: None. Stores start + step*n into the "N" elements of "data". Float
+ *         and double ranges run the dispatched ramp kernel.
+ */
+template <typename T,
+          typename std::enable_if<!vtool::simd::_is_blas_kernel<T>::value, bool>::type = true>
+void
+_ramp(const T start, const T step, T* const data, const std::size_t N)
+{
+    vtool::parallel::for_each_range(N, sizeof(T),
+        [=](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n) data[n] = start + step*static_cast<T>(n);
+        });
+}
+
+template <typename T,
+          typename vtool::simd::is_blas_kernel<T>::type = true>
+void
+_ramp(const T start, const T step, T* const data, const std::size_t N)
+{
+    void (*kernel)(T, T, T*, std::size_t, std::size_t)
+        = vtool::simd::_active_blas_kernels<T>().ramp;
+
+    vtool::parallel::for_each_range(N, sizeof(T),
+        [=](const std::size_t begin, const std::size_t end){
+            kernel(start, step, data, begin, end);
+        });
+}
+
+template <typename V, typename T>
+V
+_evaluate(const arithmetic_range<T>& range)
+{
+    V eval_vec(range.size());
+    vtool::_ramp(range.start(), range.step(), eval_vec.data(), eval_vec.size());
+
+    return eval_vec;
+}
+
+// the exponents are ramped in place first, then raised in a second sweep
+template <typename V, typename T>
+V
+_evaluate(const geometric_range<T>& range)
+{
+    const std::size_t N = range.size();
+    const T scale = range.scale();
+    const T base = range.base();
+
+    V eval_vec(N);
+    T* const data = eval_vec.data();
+    vtool::_ramp(range.exponent().start(), range.exponent().step(), data, N);
+
+    vtool::parallel::for_each_range(N, sizeof(T),
+        [=](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n) data[n] = scale * std::pow(base, data[n]);
+        });
+    return eval_vec;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o ------------------- o
+    Expression Iterator
+  o ------------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+// ------------------------ expression_iterator<E> ------------------------ //
+/*
+ * Random access iterator over the lazily computed elements. It lets
+ * std::vector's range constructor allocate once and evaluate in one pass.
+ */
+template <typename E>
+class expression_iterator
+{
+    const E* _expr;
+    std::size_t _pos;
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = typename E::value_type;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = void;
+    using reference         = value_type;
+
+    _CXX20_CONSTEXPR
+    expression_iterator(const E& expr, const std::size_t pos)
+        : _expr(&expr), _pos(pos) {}
+
+    _CXX20_CONSTEXPR inline reference
+    operator*() const { return (*_expr)[_pos]; }
+
+    _CXX20_CONSTEXPR inline reference
+    operator[](const difference_type n) const { return (*_expr)[_pos + n]; }
+
+    _CXX20_CONSTEXPR inline expression_iterator&
+    operator++() { ++_pos; return *this; }
+
+    _CXX20_CONSTEXPR inline expression_iterator&
+    operator--() { --_pos; return *this; }
+
+    _CXX20_CONSTEXPR inline expression_iterator
+    operator++(int) { expression_iterator it(*this); ++_pos; return it; }
+
+    _CXX20_CONSTEXPR inline expression_iterator
+    operator--(int) { expression_iterator it(*this); --_pos; return it; }
+
+    _CXX20_CONSTEXPR inline expression_iterator&
+    operator+=(const difference_type n) { _pos += n; return *this; }
+
+    _CXX20_CONSTEXPR inline expression_iterator&
+    operator-=(const difference_type n) { _pos -= n; return *this; }
+
+    _CXX20_CONSTEXPR inline expression_iterator
+    operator+(const difference_type n) const { return expression_iterator(*_expr, _pos + n); }
+
+    _CXX20_CONSTEXPR inline expression_iterator
+    operator-(const difference_type n) const { return expression_iterator(*_expr, _pos - n); }
+
+    _CXX20_CONSTEXPR inline difference_type
+    operator-(const expression_iterator& other) const
+    { return static_cast<difference_type>(_pos) - static_cast<difference_type>(other._pos); }
+
+    _CXX20_CONSTEXPR inline bool
+    operator==(const expression_iterator& other) const { return _pos == other._pos; }
+
+    _CXX20_CONSTEXPR inline bool
+    operator!=(const expression_iterator& other) const { return _pos != other._pos; }
+
+    _CXX20_CONSTEXPR inline bool
+    operator<(const expression_iterator& other) const { return _pos < other._pos; }
+
+    _CXX20_CONSTEXPR inline bool
+    operator>(const expression_iterator& other) const { return _pos > other._pos; }
+
+    _CXX20_CONSTEXPR inline bool
+    operator<=(const expression_iterator& other) const { return _pos <= other._pos; }
+
+    _CXX20_CONSTEXPR inline bool
+    operator>=(const expression_iterator& other) const { return _pos >= other._pos; }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o -------------------- o
+    Expression Functions
+  o -------------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+/* Syntax: vtool::eval(vtool::vector_expression expr);
+ * Return: std::vector holding the evaluated elements of "expr".
+ */
+template <typename E>
+inline std::vector<typename E::value_type, typename E::allocator_type>
+eval(const vector_expression<E>& expr)
+{
+    return vtool::_evaluate<std::vector<typename E::value_type,
+                                        typename E::allocator_type>>(expr.derived());
+}
+
+/* Syntax: vtool::sum(vtool::vector_expression expr);
+ *         vtool::mean(vtool::vector_expression expr);
+ * Return: Sum and mean value of the elements of "expr", computed without
+ *         evaluating it into a buffer.
+ */
+template <typename E>
+VTOOL_DBL
+sum(const vector_expression<E>& expr)
+{
+    const E& derived = expr.derived();
+
+    return vtool::parallel::reduce_range<VTOOL_DBL>(derived.size(), sizeof(typename E::value_type),
+        [&](const std::size_t begin, const std::size_t end){
+            VTOOL_DBL SUM = 0;
+            for (std::size_t n = begin; n < end; ++n) SUM += static_cast<VTOOL_DBL>(derived[n]);
+            return SUM;
+        }, std::plus<VTOOL_DBL>());
+}
+
+// an arithmetic range sums in closed form
+template <typename T>
+_CXX20_CONSTEXPR
+inline VTOOL_DBL
+sum(const arithmetic_range<T>& range)
+{
+    const VTOOL_DBL N = static_cast<VTOOL_DBL>(range.size());
+
+    return N * static_cast<VTOOL_DBL>(range.start())
+         + static_cast<VTOOL_DBL>(range.step()) * N * (N - 1) / 2;
+}
+
+template <typename E>
+inline VTOOL_DBL
+mean(const vector_expression<E>& expr)
+{
+    return vtool::sum(expr.derived()) / static_cast<VTOOL_DBL>(expr.derived().size());
+}
+
+/* Syntax: vtool::max(vtool::vector_expression expr);
+ *         vtool::min(vtool::vector_expression expr);
+ * Return: Maximum and minimum value of the elements of "expr".
+ */
+template <typename E>
+typename E::value_type
+max(const vector_expression<E>& expr)
+{
+    using T = typename E::value_type;
+    const E& derived = expr.derived();
+
+    return vtool::parallel::reduce_range<T>(derived.size(), sizeof(T),
+        [&](const std::size_t begin, const std::size_t end){
+            T MAX = begin < end ? derived[begin] : T();
+            for (std::size_t n = begin; n < end; ++n)
+            {
+                const T value = derived[n];
+                MAX = value > MAX ? value : MAX;
+            }
+            return MAX;
+        }, [](const T lhs, const T rhs){ return rhs > lhs ? rhs : lhs; });
+}
+
+template <typename E>
+typename E::value_type
+min(const vector_expression<E>& expr)
+{
+    using T = typename E::value_type;
+    const E& derived = expr.derived();
+
+    return vtool::parallel::reduce_range<T>(derived.size(), sizeof(T),
+        [&](const std::size_t begin, const std::size_t end){
+            T MIN = begin < end ? derived[begin] : T();
+            for (std::size_t n = begin; n < end; ++n)
+            {
+                const T value = derived[n];
+                MIN = value < MIN ? value : MIN;
+            }
+            return MIN;
+        }, [](const T lhs, const T rhs){ return rhs < lhs ? rhs : lhs; });
+}
+
+/* Syntax: vtool::linspace_range(arithmetic_type start, arithmetic_type stop, std::size_t num, bool endpoint=true);
+ * Return: vtool::arithmetic_range of the "num" points vtool::linspace would hold.
+ */
+template <typename T1, typename T2,
+          typename vtool::is_arithmetic<T1, T2>::type = true>
+_CXX20_CONSTEXPR
+inline arithmetic_range<VTOOL_DBL>
+linspace_range(const T1 start, const T2 stop, const std::size_t num,
+               const bool endpoint=true)
+{
+    const std::size_t  D = num - static_cast<std::size_t>(endpoint);
+    const VTOOL_DBL step = (stop - start) /
+                            static_cast<VTOOL_DBL>(D + (D==0));
+
+    return arithmetic_range<VTOOL_DBL>(static_cast<VTOOL_DBL>(start), step, num);
+}
+
+/* Syntax: vtool::arange_range([arithmetic_type start,] arithmetic_type stop, [arithmetic_type step]);
+ * Return: vtool::arithmetic_range from "start" (0) up to but excluding "stop"
+ *         in increments of "step" (1), typed as the common type of the bounds.
+ */
+template <typename T1, typename T2, typename T3 = int,
+          typename vtool::is_arithmetic<T1, T2, T3>::type = true>
+arithmetic_range<typename std::common_type<T1, T2, T3>::type>
+arange_range(const T1 start, const T2 stop, const T3 step=1)
+{
+    using T = typename std::common_type<T1, T2, T3>::type;
+
+    if (step == 0)
+        throw std::domain_error("Invalid Step: step must be nonzero");
+
+    const VTOOL_DBL span = std::ceil(
+        (static_cast<VTOOL_DBL>(stop) - static_cast<VTOOL_DBL>(start)) / static_cast<VTOOL_DBL>(step)
+    );
+    return arithmetic_range<T>(static_cast<T>(start), static_cast<T>(step),
+                               span > 0 ? static_cast<std::size_t>(span) : 0);
+}
+
+template <typename T,
+          typename vtool::is_arithmetic<T>::type = true>
+inline arithmetic_range<T>
+arange_range(const T stop)
+{
+    return vtool::arange_range(T(0), stop, T(1));
+}
+
+/* Syntax: vtool::logspace_range(arithmetic_type start, arithmetic_type stop, std::size_t num,
+ *                               bool endpoint=true, arithmetic_type base=10);
+ * Return: vtool::geometric_range of "num" points from base^start to base^stop.
+ */
+template <typename T1, typename T2, typename T3 = VTOOL_DBL,
+          typename vtool::is_arithmetic<T1, T2, T3>::type = true>
+inline geometric_range<VTOOL_DBL>
+logspace_range(const T1 start, const T2 stop, const std::size_t num,
+               const bool endpoint=true, const T3 base=10)
+{
+    return geometric_range<VTOOL_DBL>(1, static_cast<VTOOL_DBL>(base),
+                                      vtool::linspace_range(start, stop, num, endpoint));
+}
+
+/* Syntax: vtool::geomspace_range(arithmetic_type start, arithmetic_type stop, std::size_t num, bool endpoint=true);
+ * Return: vtool::geometric_range of "num" points from "start" to "stop" with
+ *         a constant ratio. Both bounds must be nonzero and share a sign.
+ */
+template <typename T1, typename T2,
+          typename vtool::is_arithmetic<T1, T2>::type = true>
+inline geometric_range<VTOOL_DBL>
+geomspace_range(const T1 start, const T2 stop, const std::size_t num,
+                const bool endpoint=true)
+{
+    if (start == 0 || stop == 0)
+        throw std::domain_error("Invalid Bound: geomspace bounds must be nonzero");
+    if ((start < 0) != (stop < 0))
+        throw std::domain_error("Invalid Bound: geomspace bounds must share a sign");
+
+    const VTOOL_DBL scale = start < 0 ? -1 : 1;
+
+    return geometric_range<VTOOL_DBL>(scale, 10,
+        vtool::linspace_range(std::log10(scale * start), std::log10(scale * stop), num, endpoint));
+}
+
+template <typename Op, typename L, typename R>
+_CXX20_CONSTEXPR
+inline binary_expression<Op, L, R>
+make_binary_expression(const L& lhv, const R& rhv)
+{
+    return binary_expression<Op, L, R>(lhv, rhv);
+}
+
+// ---------------------- is_result_storage<V, L, R> ---------------------- //
+/*
+ * True when "L op R" evaluates to exactly V, so an expiring V operand can
+ * hold the result instead of a freshly allocated vector.
+ */
+template <typename V, typename L, typename R>
+struct _is_result_storage: std::is_same<V, std::vector<
+    typename binary_expression<_plus, L, R>::value_type,
+    typename binary_expression<_plus, L, R>::allocator_type
+>> {};
+
+template <typename V, typename L, typename R>
+struct is_result_storage: std::enable_if<
+    combination<_is_expression_operands<L, R>,
+                _is_result_storage<V, L, R>>::value, bool
+> {};
+
+// an rvalue vector on the left side is reused before the one on the right
+template <typename L, typename V>
+struct is_right_storage: std::enable_if<
+    combination<_is_expression_operands<typename std::decay<L>::type, V>,
+                _is_result_storage<V, typename std::decay<L>::type, V>>::value
+    && !combination<std::integral_constant<bool, !std::is_lvalue_reference<L>::value>,
+                    _is_vector<typename std::decay<L>::type>,
+                    _is_result_storage<typename std::decay<L>::type,
+                                       typename std::decay<L>::type, V>>::value, bool
+> {};
+
+// operand type of binary_expression for an argument deduced as "L",
+// std::vector&& for an expiring std::vector
+template <typename L>
+using _expression_arg_t = typename std::conditional<
+    !std::is_reference<L>::value && _is_vector<L>::value,
+    L&&, typename std::decay<L>::type
+>::type;
+
+// an expiring vector on the left side not reused as the result is moved
+// into the expression
+template <typename V, typename R>
+struct is_owned_left: std::enable_if<
+    _is_expression_operands<V, R>::value && !_is_result_storage<V, V, R>::value, bool
+> {};
+
+// the same for an expiring vector on the right side, unless one of the
+// two operands is reused as the result
+template <typename L, typename V>
+struct is_owned_right: std::enable_if<
+    _is_expression_operands<typename std::decay<L>::type, V>::value
+    && !_is_result_storage<V, typename std::decay<L>::type, V>::value
+    && !combination<std::integral_constant<bool, !std::is_lvalue_reference<L>::value>,
+                    _is_vector<typename std::decay<L>::type>,
+                    _is_result_storage<typename std::decay<L>::type,
+                                       typename std::decay<L>::type, V>>::value, bool
+> {};
+
+// at least one argument deduced as "L" or "R" is an expiring expression,
+// which is moved into the new node; expiring vectors are left to the
+// storage reusing operators
+template <typename L, typename R>
+struct is_forwarded_operands: std::enable_if<
+    _is_expression_operands<typename std::decay<L>::type, typename std::decay<R>::type>::value
+    && ((!std::is_reference<L>::value && _is_expression<L>::value)
+     || (!std::is_reference<R>::value && _is_expression<R>::value))
+    && !(!std::is_reference<L>::value && _is_vector<L>::value)
+    && !(!std::is_reference<R>::value && _is_vector<R>::value), bool
+> {};
+
+/* Syntax: vtool::_assign_from_left<Op>(operand lhv, std::vector rhv);
+ * Return: None. Stores "lhv op rhv" element-wise into the storage of "rhv".
+ */
+template <typename Op, typename L, typename T, typename Alloc,
+          typename std::enable_if<!std::is_same<T, bool>::value, bool>::type = true>
+void
+_assign_from_left(const L& lhv, std::vector<T, Alloc>& rhv)
+{
+    const typename _expression_operand<L>::type& lhs = _expression_operand<L>::wrap(lhv);
+    T* const data = rhv.data();
+
+    vtool::parallel::for_each_range(rhv.size(), sizeof(T),
+        [&](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n)
+                data[n] = Op::template apply<T>(static_cast<T>(lhs[n]), data[n]);
+        });
+}
+
+// std::vector<bool> packs its elements, so it is never written from two threads
+template <typename Op, typename L, typename Alloc>
+void
+_assign_from_left(const L& lhv, std::vector<bool, Alloc>& rhv)
+{
+    const typename _expression_operand<L>::type& lhs = _expression_operand<L>::wrap(lhv);
+
+    for (std::size_t n = 0; n < rhv.size(); ++n)
+        rhv[n] = Op::template apply<bool>(static_cast<bool>(lhs[n]), rhv[n]);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o ---------------------- o
+    Writing through a View
+  o ---------------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+/* Syntax: vtool::_compound_loop<Op>(vtool::view lhv, expression node rhs);
+ * Return: None. Stores "lhv op rhs" element-wise into the elements of "lhv".
+ */
+template <typename Op, typename T, typename N>
+void
+_compound_loop(const view<T>& lhv, const N& rhs)
+{
+    using V = typename view<T>::value_type;
+    using C = typename std::common_type<V, typename N::value_type>::type;
+
+    vtool::parallel::for_each_range(lhv.size(), sizeof(V),
+        [&](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n)
+                lhv[n] = static_cast<V>(Op::template apply<C>(static_cast<C>(lhv[n]),
+                                                              static_cast<C>(rhs[n])));
+        });
+}
+
+/* Syntax: vtool::_compound_assign<Op>(vtool::view lhv, operand rhv);
+ * Return: None. Stores "lhv op rhv" into the elements of "lhv". Contiguous
+ *         same-typed operands run the dispatched SIMD kernel.
+ */
+template <typename Op, typename T, typename R>
+void
+_compound_assign(const view<T>& lhv, const R& rhv)
+{
+    vtool::_compound_loop<Op>(lhv, _expression_operand<R>::wrap(rhv));
+}
+
+template <typename Op, typename T,
+          typename vtool::simd::is_kernel<T>::type = true>
+void
+_compound_assign(const view<T>& lhv, const view<const T>& rhv)
+{
+    if (!lhv.is_contiguous() || !rhv.is_contiguous())
+    {
+        vtool::_compound_loop<Op>(lhv, rhv);
+        return;
+    }
+
+    const _compound_kernel_t<T> kernel = Op::template kernel<T>();
+    T* const dst = lhv.data();
+    const T* const src = rhv.data();
+
+    vtool::parallel::for_each_range(lhv.size(), sizeof(T),
+        [=](const std::size_t begin, const std::size_t end){
+            kernel(dst + begin, src + begin, end - begin);
+        });
+}
+
+template <typename Op, typename T,
+          typename vtool::simd::is_kernel<T>::type = true>
+inline void
+_compound_assign(const view<T>& lhv, const view<T>& rhv)
+{
+    vtool::_compound_assign<Op>(lhv, view<const T>(rhv));
+}
+
+template <typename Op, typename T, typename Alloc,
+          typename vtool::simd::is_kernel<T>::type = true>
+inline void
+_compound_assign(const view<T>& lhv, const std::vector<T, Alloc>& rhv)
+{
+    vtool::_compound_assign<Op>(lhv, view<const T>(rhv));
+}
+
+/* Syntax: vtool::eval_into(vtool::vector_expression expr, vtool::view out);
+ * Return: "out" holding the evaluated elements of "expr".
+ */
+template <typename E, typename T>
+view<T>
+eval_into(const vector_expression<E>& expr, const view<T> out)
+{
+    const E& derived = expr.derived();
+    _vtool_length_check(derived, out);
+
+    vtool::parallel::for_each_range(out.size(), sizeof(T),
+        [&](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n) out[n] = static_cast<T>(derived[n]);
+        });
+    return out;
+}
+
+}   // namespace vtool
+
+#endif  // __VTOOL_EXPRESSION_H__
@@ -9,12 +9,27 @@
 #ifndef __VTOOL_FFT_H__
 #define __VTOOL_FFT_H__
 
+#include <map>
+#include <cmath>
+#include <mutex>
+#include <atomic>
+#include <memory>
 #include <vector>
 #include <complex>
 #include <cstddef>
+#include <utility>
+#include <stdexcept>
+#include <functional>
+#include <typeinfo>
+#include <typeindex>
+#include <limits>
+#include <algorithm>
 
+#include "vtool_view.h"
 #include "vtool_utils.h"
 #include "vtool_traits.h"
+#include "vtool_parallel.h"
+#include "vtool_windows.h"
 
 #include "pocketfft/pocketfft_hdronly.h"
 
@@ -25,6 +40,7 @@ namespace pfft = pocketfft;
 
 namespace fft_c {
 
+    // default of vtool::fft_threads::num_threads(), 0 is automatic
     static const std::size_t
     nThread
 #ifdef USE_DEFAULT_MULTITHREADING
@@ -32,57 +48,780 @@ namespace fft_c {
 #else
     = 1;
 #endif
-    
-    static const
-    pfft::shape_t AXIS{ 0 };
-    
-#ifdef _CXX14_FLAG
-    template <typename T>
+
+    // points per thread aimed at by vtool::fft_threads::automatic()
+    static const std::size_t
+    thread_points = std::size_t(1) << 16;
+
+    // single transforms from this length on can be split over threads
+    static const std::size_t
+    split_size = std::size_t(1) << 20;
+
     static const
-    pfft::stride_t _real_stride{sizeof(T)};
+    long double pi = 3.141592653589793238462643383279502884l;
     
-    template <typename T>
     static const
-    pfft::stride_t _cmplx_stride{sizeof(std::complex<T>)};
-    
-#   define _REAL_STRIDE(T)  fft_c::_real_stride<T>
-#   define _CMPLX_STRIDE(T) fft_c::_cmplx_stride<T>
-#else
-#   define _REAL_STRIDE(T)  pfft::stride_t{sizeof(T)}
-#   define _CMPLX_STRIDE(T) pfft::stride_t{sizeof(std::complex<T>)}
-#endif
+    pfft::shape_t AXIS{ 0 };
+
+    // plans kept by vtool::fft_cache before the least recently used is dropped
+    static const std::size_t cache_capacity = 64;
+
+    // segments summed per block by vtool::welch_plan
+    static const std::size_t psd_block = 16;
+
+    // blocks held at once by vtool::welch_plan, bounding its scratch memory
+    static const std::size_t psd_group = 16;
 }   // namespace fft_c
 
 #define _SHAPE(N) pfft::shape_t{ N }
 #define _AXIS     fft_c::AXIS
 
+// byte stride of a vtool::view for pocketfft
+#define _VIEW_STRIDE(vw) \
+    pfft::stride_t{ (vw).stride() * static_cast<std::ptrdiff_t>(sizeof(*(vw).data())) }
+
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o --------- o
+    FFT Plans
+  o --------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+/*
+ * A plan holds the factorization and twiddle factors of one transform length.
+ * Plans never change once built, so a single plan is shared by every thread,
+ * and the library-wide cache hands out the same plan to every call at the
+ * same length and type instead of building a new one per call.
+ */
+
+namespace fft_cache {
+
+// ------------------------------- fft_cache ------------------------------ //
+struct info
+{
+    std::size_t hits;
+    std::size_t misses;
+    std::size_t entries;
+    std::size_t bytes;      // approximate memory held by the cached plans
+
+    double
+    hit_rate() const
+    { return hits + misses ? static_cast<double>(hits) / (hits + misses) : 0.0; }
+};
+
+struct _key
+{
+    std::size_t N;
+    std::type_index type;
+
+    bool
+    operator<(const _key& other) const
+    { return N < other.N || (N == other.N && type < other.type); }
+};
+
+struct _entry
+{
+    std::shared_ptr<const void> plan;
+    std::size_t bytes;
+    std::size_t last_use;
+};
+
+struct _cache
+{
+    std::mutex mutex;
+    std::map<_key, _entry> plans;
+    std::size_t capacity;
+    std::size_t clock;
+    std::size_t hits;
+    std::size_t misses;
+    std::size_t bytes;
+
+    _cache()
+        : capacity(fft_c::cache_capacity), clock(0), hits(0), misses(0), bytes(0) {}
+
+    // drops the least recently used plans, the caller holds "mutex"
+    void
+    _shrink()
+    {
+        while (plans.size() > capacity)
+        {
+            const auto lru = std::min_element(plans.begin(), plans.end(),
+                [](const std::pair<const _key, _entry>& lhs,
+                   const std::pair<const _key, _entry>& rhs){
+                    return lhs.second.last_use < rhs.second.last_use;
+                });
+            bytes -= lru->second.bytes;
+            plans.erase(lru);
+        }
+    }
+};
+
+inline _cache&
+_state()
+{
+    static _cache cache;
+    return cache;
+}
+
+/* Syntax: vtool::fft_cache::get<Plan>(std::size_t N, std::size_t bytes);
+ * Return: std::shared_ptr to the cached "Plan" of length N, built on a miss.
+ *         "bytes" is the approximate size of the plan for vtool::fft_cache::stats().
+ */
+template <typename Plan>
+std::shared_ptr<const Plan>
+get(const std::size_t N, const std::size_t bytes)
+{
+    _cache& cache = _state();
+    const _key key{ N, std::type_index(typeid(Plan)) };
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        const auto it = cache.plans.find(key);
+
+        if (it != cache.plans.end())
+        {
+            ++cache.hits;
+            it->second.last_use = ++cache.clock;
+            return std::static_pointer_cast<const Plan>(it->second.plan);
+        }
+        ++cache.misses;
+    }
+
+    // plans are built outside the lock, racing misses keep the first one stored
+    const std::shared_ptr<const Plan> plan = std::make_shared<Plan>(N);
+
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    const auto inserted = cache.plans.insert(
+        std::make_pair(key, _entry{ plan, bytes, ++cache.clock })
+    );
+
+    if (!inserted.second)
+        return std::static_pointer_cast<const Plan>(inserted.first->second.plan);
+
+    cache.bytes += bytes;
+    cache._shrink();
+    return plan;
+}
+
+/* Syntax: vtool::fft_cache::stats();
+ * Return: vtool::fft_cache::info holding the hits, misses, number of plans
+ *         and approximate bytes of the plan cache.
+ */
+inline info
+stats()
+{
+    _cache& cache = _state();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+
+    return info{ cache.hits, cache.misses, cache.plans.size(), cache.bytes };
+}
+
+/* Syntax: vtool::fft_cache::clear();
+ * Return: None. Drops every cached plan and resets the statistics. Plans
+ *         still held by a vtool::fft_plan stay alive until it is destroyed.
+ */
+inline void
+clear()
+{
+    _cache& cache = _state();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+
+    cache.plans.clear();
+    cache.hits = cache.misses = cache.bytes = 0;
+}
+
+/* Syntax: vtool::fft_cache::set_capacity(std::size_t nPlan);
+ * Return: None. Keeps at most "nPlan" plans, least recently used ones first out.
+ */
+inline void
+set_capacity(const std::size_t nPlan)
+{
+    _cache& cache = _state();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+
+    cache.capacity = nPlan;
+    cache._shrink();
+}
+
+inline std::size_t
+capacity()
+{
+    _cache& cache = _state();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+
+    return cache.capacity;
+}
+
+}   // namespace fft_cache
+
+namespace fft_threads {
+
+// ------------------------------ fft_threads ----------------------------- //
+inline std::atomic<std::size_t>&
+_state()
+{
+    static std::atomic<std::size_t> nThread(fft_c::nThread);
+    return nThread;
+}
+
+/* Syntax: vtool::fft_threads::set_num_threads(std::size_t nThread);
+ * Return: None. Thread count of every transform that does not ask for its
+ *         own. 0 picks it per transform with vtool::fft_threads::automatic().
+ */
+inline void
+set_num_threads(const std::size_t nThread)
+{ _state() = nThread; }
+
+inline std::size_t
+num_threads()
+{ return _state(); }
+
+/* Syntax: vtool::fft_threads::automatic(std::size_t N, std::size_t nBatch=1);
+ * Return: Thread count for "nBatch" transforms of N points: one thread per
+ *         fft_c::thread_points points, at most one per frame and at most
+ *         vtool::parallel::num_threads(). A single transform is only split
+ *         from fft_c::split_size points on.
+ */
+inline std::size_t
+automatic(const std::size_t N, const std::size_t nBatch=1)
+{
+    if (nBatch < 2 && N < fft_c::split_size)
+        return 1;
+
+    std::size_t nThread = std::min(N * nBatch / fft_c::thread_points,
+                                   vtool::parallel::num_threads());
+    if (nBatch > 1)
+        nThread = std::min(nThread, nBatch);
+
+    return std::max<std::size_t>(nThread, 1);
+}
+
+// "nThread" when given, else the process-wide count, else the automatic one
+inline std::size_t
+_resolve(const std::size_t nThread, const std::size_t N, const std::size_t nBatch=1)
+{
+    const std::size_t n = nThread ? nThread : num_threads();
+    return n ? n : automatic(N, nBatch);
+}
+
+}   // namespace fft_threads
+
+// ------------------------------ _fft_split ------------------------------ //
+/* Syntax: vtool::_fft_split_factor(std::size_t N);
+ * Return: Largest factor N1 <= sqrt(N) of "N", or 0 when N has no factor
+ *         large enough to split the transform over threads.
+ */
+inline std::size_t
+_fft_split_factor(const std::size_t N)
+{
+    if (N < fft_c::split_size)
+        return 0;
+
+    std::size_t N1 = static_cast<std::size_t>(std::sqrt(static_cast<double>(N)));
+    while (N1 * N1 > N) --N1;
+    while (N % N1 != 0) --N1;
+
+    return N1 >= 64 ? N1 : 0;
+}
+
+/* Syntax: vtool::_fft_split(vtool::view in, vtool::view out, bool forward, T fct,
+ *                           std::size_t N1, std::size_t nThread);
+ * Return: None. Stores the transform of the N = N1*N2 points of "in" into
+ *         "out" as N2 transforms of N1 points, a twiddle pass and N1
+ *         transforms of N2 points, each stage spread over "nThread" threads.
+ *         Goes through one scratch buffer of N points, "out" may be "in".
+ */
+template <typename T>
+void
+_fft_split(const view<const std::complex<T>> in, const view<std::complex<T>> out,
+           const bool forward, const T fct, const std::size_t N1, const std::size_t nThread)
+{
+    const std::size_t N = in.size();
+    const std::size_t N2 = N / N1;
+    const std::ptrdiff_t step = static_cast<std::ptrdiff_t>(sizeof(std::complex<T>));
+    const std::ptrdiff_t in_step = in.stride() * step;
+    const std::ptrdiff_t out_step = out.stride() * step;
+
+    std::vector<std::complex<T>> buf(N);
+
+    // buf[k1][n2]: transforms of the columns in[N2*n1 + n2] over n1
+    pfft::c2c(pfft::shape_t{ N1, N2 },
+              pfft::stride_t{ static_cast<std::ptrdiff_t>(N2) * in_step, in_step },
+              pfft::stride_t{ static_cast<std::ptrdiff_t>(N2) * step, step },
+              pfft::shape_t{ 0 }, forward, in.data(), buf.data(), static_cast<T>(1.0), nThread);
+
+    // buf[k1][n2] *= W^(k1*n2), exact every 64 points and by recurrence in between
+    const VTOOL_DBL w = (forward ? -2 : 2) * fft_c::pi / N;
+    const std::function<void(std::size_t)> twiddle = [&](const std::size_t k1){
+        std::complex<T>* const row = buf.data() + k1*N2;
+        const std::complex<VTOOL_DBL> rot = std::polar<VTOOL_DBL>(1, w * k1);
+
+        for (std::size_t n2 = 0; n2 < N2; n2 += 64)
+        {
+            std::complex<VTOOL_DBL> tw = std::polar<VTOOL_DBL>(1, w * (k1*n2));
+
+            for (std::size_t n = n2; n < std::min(n2 + 64, N2); ++n, tw *= rot)
+                row[n] *= static_cast<std::complex<T>>(tw);
+        }
+    };
+
+    if (nThread > 1 && vtool::parallel::num_threads() > 1)
+        vtool::parallel::pool()->run(N1, twiddle);
+    else
+        for (std::size_t k1 = 0; k1 < N1; ++k1) twiddle(k1);
+
+    // out[k1 + N1*k2]: transforms of the rows buf[k1] over n2
+    pfft::c2c(pfft::shape_t{ N1, N2 },
+              pfft::stride_t{ static_cast<std::ptrdiff_t>(N2) * step, step },
+              pfft::stride_t{ out_step, static_cast<std::ptrdiff_t>(N1) * out_step },
+              pfft::shape_t{ 1 }, forward, buf.data(), out.data(), fct, nThread);
+}
+
+// ------------------------------ fft_plan<T> ----------------------------- //
+/*
+ * Complex transform of "size" points. Contiguous buffers are transformed in
+ * "out" itself without any allocation by vtool, strided views go through
+ * pocketfft's general interface.
+ */
+template <typename T>
+class fft_plan
+{
+    using _plan_t = pfft::detail::pocketfft_c<T>;
+
+    std::shared_ptr<const _plan_t> _plan;
+    std::size_t _size;
+    std::size_t _nThread;
+    std::size_t _split;
+
+  public:
+    using value_type = std::complex<T>;
+
+    // "nThread" 0 follows vtool::fft_threads::num_threads()
+    explicit
+    fft_plan(const std::size_t N, const std::size_t nThread=0)
+        : _plan(N ? fft_cache::get<_plan_t>(N, sizeof(_plan_t) + N*sizeof(value_type))
+                  : nullptr),
+          _size(N), _nThread(nThread), _split(vtool::_fft_split_factor(N)) {}
+
+    inline std::size_t
+    size() const { return _size; }
+
+    inline std::size_t
+    num_threads() const { return _nThread; }
+
+    /* Syntax: plan.execute(vtool::view in, vtool::view out, bool forward, T fct);
+     * Return: None. Stores the transform of "in" scaled by "fct" into "out",
+     *         which may be "in" itself.
+     */
+    void
+    execute(const view<const value_type> in, const view<value_type> out,
+            const bool forward, const T fct) const
+    {
+        _vtool_size_check(in, _size);
+        _vtool_size_check(out, _size);
+
+        if (_size == 0)
+            return;
+
+        const std::size_t nThread = fft_threads::_resolve(_nThread, _size);
+
+        if (_split && nThread > 1)
+        {
+            vtool::_fft_split(in, out, forward, fct, _split, nThread);
+            return;
+        }
+        if (!in.is_contiguous() || !out.is_contiguous())
+        {
+            pfft::c2c(_SHAPE(_size), _VIEW_STRIDE(in), _VIEW_STRIDE(out), _AXIS, forward,
+                      in.data(), out.data(), fct, nThread);
+            return;
+        }
+
+        if (in.data() != out.data())
+            std::copy(in.data(), in.data() + _size, out.data());
+        _plan->exec(reinterpret_cast<pfft::detail::cmplx<T>*>(out.data()), fct, forward);
+    }
+
+    /* Syntax: plan.execute(vtool::view in, vtool::view out, bool forward=pfft::FORWARD);
+     * Return: "out" holding the forward FFT of "in", or its inverse FFT
+     *         scaled by 1/N like vtool::ifft().
+     */
+    view<value_type>
+    execute(const view<const value_type> in, const view<value_type> out,
+            const bool forward=pfft::FORWARD) const
+    {
+        execute(in, out, forward, forward ? static_cast<T>(1.0)
+                                          : static_cast<T>(1.0)/_size);
+        return out;
+    }
+};
+
+// ----------------------------- rfft_plan<T> ----------------------------- //
+/*
+ * Real transform of "size" points between "size" samples and the size/2+1
+ * non-negative frequency bins. The halfcomplex output of pocketfft is
+ * unpacked inside the complex buffer itself, so contiguous outputs need no
+ * scratch buffer.
+ */
+template <typename T>
+class rfft_plan
+{
+    using _plan_t = pfft::detail::pocketfft_r<T>;
+
+    std::shared_ptr<const _plan_t> _plan;
+    std::size_t _size;
+    std::size_t _nThread;
+    std::size_t _split;
+
+  public:
+    using value_type = T;
+
+    // "nThread" 0 follows vtool::fft_threads::num_threads()
+    explicit
+    rfft_plan(const std::size_t N, const std::size_t nThread=0)
+        : _plan(N ? fft_cache::get<_plan_t>(N, sizeof(_plan_t) + N*sizeof(T))
+                  : nullptr),
+          _size(N), _nThread(nThread), _split(vtool::_fft_split_factor(N)) {}
+
+    inline std::size_t
+    size() const { return _size; }
+
+    inline std::size_t
+    num_threads() const { return _nThread; }
+
+    /* Syntax: plan.execute(vtool::view<real> in, vtool::view<complex> out);
+     * Return: "out" holding the size/2+1 non-negative frequency bins of "in".
+     */
+    view<std::complex<T>>
+    execute(const view<const T> in, const view<std::complex<T>> out) const
+    {
+        _vtool_size_check(in, _size);
+        _vtool_size_check(out, _size/2+1);
+
+        if (_size == 0)
+            return out;
+
+        const std::size_t nThread = fft_threads::_resolve(_nThread, _size);
+
+        // split transforms run the complex transform of the widened input
+        if (_split && nThread > 1)
+        {
+            std::vector<std::complex<T>> full(in.begin(), in.end());
+            vtool::_fft_split(view<const std::complex<T>>(full), view<std::complex<T>>(full),
+                              pfft::FORWARD, static_cast<T>(1.0), _split, nThread);
+            std::copy(full.begin(), full.begin() + (_size/2+1), out.begin());
+            return out;
+        }
+        if (!out.is_contiguous())
+        {
+            pfft::r2c(_SHAPE(_size), _VIEW_STRIDE(in), _VIEW_STRIDE(out), 0, pfft::FORWARD,
+                      in.data(), out.data(), static_cast<T>(1.0), nThread);
+            return out;
+        }
+
+        // one sample ahead, the halfcomplex r0, r1, i1, r2, i2, ... lands as
+        // complex pairs; copied backwards in case "in" starts at "out"
+        T* const buf = reinterpret_cast<T*>(out.data());
+        for (std::size_t n = _size; n > 0; --n)
+            buf[n] = in[n-1];
+
+        _plan->exec(buf + 1, static_cast<T>(1.0), pfft::FORWARD);
+        buf[0] = buf[1];
+        buf[1] = 0;
+        if (_size % 2 == 0)
+            buf[_size+1] = 0;
+
+        return out;
+    }
+
+    /* Syntax: plan.execute(vtool::view<complex> in, vtool::view<real> out);
+     * Return: "out" holding the real inverse FFT of the size/2+1 bins of "in",
+     *         scaled by 1/N like vtool::irfft().
+     */
+    view<T>
+    execute(const view<const std::complex<T>> in, const view<T> out) const
+    {
+        _vtool_size_check(in, _size/2+1);
+        _vtool_size_check(out, _size);
+
+        if (_size == 0)
+            return out;
+
+        const std::size_t nThread = fft_threads::_resolve(_nThread, _size);
+
+        // split transforms run the complex transform of the Hermitian spectrum
+        if (_split && nThread > 1)
+        {
+            std::vector<std::complex<T>> full(_size);
+
+            full[0] = in[0].real();
+            for (std::size_t k = 1; k < _size; ++k)
+                full[k] = 2*k < _size ? in[k] : std::conj(in[_size-k]);
+            if (_size % 2 == 0)
+                full[_size/2] = in[_size/2].real();
+
+            vtool::_fft_split(view<const std::complex<T>>(full), view<std::complex<T>>(full),
+                              pfft::BACKWARD, static_cast<T>(1.0)/_size, _split, nThread);
+            for (std::size_t n = 0; n < _size; ++n)
+                out[n] = full[n].real();
+            return out;
+        }
+        if (!out.is_contiguous())
+        {
+            pfft::c2r(_SHAPE(_size), _VIEW_STRIDE(in), _VIEW_STRIDE(out), 0, pfft::BACKWARD,
+                      in.data(), out.data(), static_cast<T>(1.0)/_size, nThread);
+            return out;
+        }
+
+        // packs the bins into halfcomplex order front to back, each pair read
+        // before it is overwritten in case "out" starts at "in"
+        T* const buf = out.data();
+        buf[0] = in[0].real();
+        for (std::size_t k = 1; 2*k < _size; ++k)
+        {
+            const std::complex<T> bin = in[k];
+            buf[2*k-1] = bin.real();
+            buf[2*k]   = bin.imag();
+        }
+        if (_size % 2 == 0 && _size > 1)
+            buf[_size-1] = in[_size/2].real();
+
+        _plan->exec(buf, static_cast<T>(1.0)/_size, pfft::BACKWARD);
+        return out;
+    }
+};
+
 //////////////////////////////////////////////////////////////////////////////
-// ----------------------------- forward fft ------------------------------ //
+/*
+  o ----------------------------------- o
+    Transforms over Strided vtool::view
+  o ----------------------------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+/*
+ * pocketfft reads and writes through byte strides, so a strided view is
+ * transformed where it lies without being gathered into a std::vector.
+ */
+
+template <typename T>
+struct _fft_real { using type = T; };
+
+template <typename T>
+struct _fft_real<std::complex<T>> { using type = T; };
+
+template <typename T>
+using _fft_real_t = typename _fft_real<typename std::remove_cv<T>::type>::type;
+
+// complex to complex
+template <typename T>
+void
+_c2c(const view<const std::complex<T>> vw, const view<std::complex<T>> out,
+     const bool forward, const T fct)
+{
+    fft_plan<T>(vw.size()).execute(vw, out, forward, fct);
+}
+
+// the spectrum of real input is Hermitian, so only N/2+1 bins are transformed
+template <typename T>
+void
+_c2c(const view<const T> vw, const view<std::complex<T>> out,
+     const bool forward, const T fct)
+{
+    const std::size_t N = vw.size();
+    _vtool_length_check(vw, out);
+
+    if (N == 0)
+        return;
+    rfft_plan<T>(N).execute(vw, out.subview(0, N/2+1));
+
+    for (std::size_t k = N/2+1; k < N; ++k)
+        out[k] = std::conj(out[N-k]);
+
+    // the inverse transform of real input is the conjugate of the forward one
+    if (!forward || fct != static_cast<T>(1.0))
+        for (std::size_t k = 0; k < N; ++k)
+            out[k] = (forward ? out[k] : std::conj(out[k])) * fct;
+}
+
+// real to complex
+template <typename T>
+void
+_r2c(const view<const T> vw, const view<std::complex<T>> out)
+{
+    rfft_plan<T>(vw.size()).execute(vw, out);
+}
+
+// the real parts are packed into the front of a contiguous "out", front to
+// back so that "out" may start at "vw"
+template <typename T>
+void
+_r2c(const view<const std::complex<T>> vw, const view<std::complex<T>> out)
+{
+    const std::size_t N = vw.size();
+    _vtool_size_check(out, N/2+1);
+
+    if (!out.is_contiguous())
+    {
+        std::vector<T> real_vec(N, 0);
+
+        for (std::size_t i = 0; i < N; ++i)
+            real_vec[i] = vw[i].real();
+
+        vtool::_r2c(view<const T>(real_vec), out);
+        return;
+    }
+
+    T* const buf = reinterpret_cast<T*>(out.data());
+
+    for (std::size_t i = 0; i < N; ++i)
+        buf[i] = vw[i].real();
+
+    vtool::_r2c(view<const T>(buf, N), out);
+}
+
+// complex to real
+template <typename T>
+void
+_c2r(const view<const std::complex<T>> vw, const view<T> out)
+{
+    rfft_plan<T>(out.size()).execute(vw, out);
+}
+
+template <typename T>
+void
+_c2r(const view<const T> vw, const view<T> out)
+{
+    const std::size_t N = vw.size();
+    _vtool_length_check(vw, out);
+
+    if (N == 0)
+        return;
+    pfft::r2r_fftpack(_SHAPE(N), _VIEW_STRIDE(vw), _VIEW_STRIDE(out), _AXIS, false, pfft::BACKWARD,
+                      vw.data(), out.data(), static_cast<T>(1.0)/N, fft_threads::_resolve(0, N));
+}
+
+// irfft of N inputs gives 2*(N-1) samples, or N samples from fftpack order
+template <typename T>
+inline std::size_t
+_irfft_size(const view<const std::complex<T>> vw)
+{ return vw.empty() ? 0 : 2*(vw.size()-1); }
+
+template <typename T>
+inline std::size_t
+_irfft_size(const view<const T> vw)
+{ return vw.size(); }
+
+// inputs needed for N samples: N/2+1 bins, so odd N can be requested too
+template <typename T>
+inline std::size_t
+_irfft_bins(const view<const std::complex<T>>, const std::size_t N)
+{ return N/2+1; }
+
+template <typename T>
+inline std::size_t
+_irfft_bins(const view<const T>, const std::size_t N)
+{ return N; }
+
+// ---------------------------- caller buffers ---------------------------- //
+/* Syntax: vtool::fft_into(std::vector vec, std::vector<complex> out);
+ * Return: Reference to "out" resized to "vec" and holding its forward FFT.
+ *         The capacity of "out" is reused, and "out" may be "vec" itself.
+ */
+template <typename T, typename Alloc, typename AllocOut>
+std::vector<std::complex<_fft_real_t<T>>, AllocOut>&
+fft_into(const std::vector<T, Alloc>& vec,
+         std::vector<std::complex<_fft_real_t<T>>, AllocOut>& out)
+{
+    out.resize(vec.size());
+    vtool::_c2c(view<const T>(vec), view<std::complex<_fft_real_t<T>>>(out),
+                pfft::FORWARD, static_cast<_fft_real_t<T>>(1.0));
+    return out;
+}
+
+/* Syntax: vtool::ifft_into(std::vector vec, std::vector<complex> out);
+ * Return: Reference to "out" resized to "vec" and holding its inverse FFT.
+ *         The capacity of "out" is reused, and "out" may be "vec" itself.
+ */
+template <typename T, typename Alloc, typename AllocOut>
+std::vector<std::complex<_fft_real_t<T>>, AllocOut>&
+ifft_into(const std::vector<T, Alloc>& vec,
+          std::vector<std::complex<_fft_real_t<T>>, AllocOut>& out)
+{
+    out.resize(vec.size());
+    vtool::_c2c(view<const T>(vec), view<std::complex<_fft_real_t<T>>>(out),
+                pfft::BACKWARD, static_cast<_fft_real_t<T>>(1.0)/vec.size());
+    return out;
+}
+
+/* Syntax: vtool::rfft_into(std::vector vec, std::vector<complex> out);
+ * Return: Reference to "out" resized to the N/2+1 non-negative frequency
+ *         bins of "vec". The capacity of "out" is reused.
+ */
+template <typename T, typename Alloc, typename AllocOut>
+std::vector<std::complex<_fft_real_t<T>>, AllocOut>&
+rfft_into(const std::vector<T, Alloc>& vec,
+          std::vector<std::complex<_fft_real_t<T>>, AllocOut>& out)
+{
+    out.resize(vec.size()/2+1);
+    vtool::_r2c(view<const T>(vec), view<std::complex<_fft_real_t<T>>>(out));
+
+    return out;
+}
+
+/* Syntax: vtool::irfft_into(std::vector vec, std::vector<real> out);
+ * Return: Reference to "out" resized to and holding the real inverse FFT
+ *         of "vec". The capacity of "out" is reused.
+ */
+template <typename T, typename Alloc, typename AllocOut>
+std::vector<_fft_real_t<T>, AllocOut>&
+irfft_into(const std::vector<T, Alloc>& vec, std::vector<_fft_real_t<T>, AllocOut>& out)
+{
+    const view<const T> in(vec);
+
+    out.resize(vtool::_irfft_size(in));
+    vtool::_c2r(in, view<_fft_real_t<T>>(out));
+
+    return out;
+}
+
+/* Syntax: vtool::fft_inplace(std::vector<complex> vec);
+ *         vtool::ifft_inplace(std::vector<complex> vec);
+ * Return: Reference to "vec" holding its forward or inverse FFT.
+ */
+template <typename T, typename Alloc>
+inline std::vector<std::complex<T>, Alloc>&
+fft_inplace(std::vector<std::complex<T>, Alloc>& vec)
+{
+    return vtool::fft_into(vec, vec);
+}
+
+template <typename T, typename Alloc>
+inline std::vector<std::complex<T>, Alloc>&
+ifft_inplace(std::vector<std::complex<T>, Alloc>& vec)
+{
+    return vtool::ifft_into(vec, vec);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// ------------------------------ forward fft ----------------------------- //
 // complex to complex
 template <typename T, typename Alloc>
 std::vector<std::complex<T>, Alloc>
 fft(const std::vector<std::complex<T>, Alloc>& vec)
 {
-    const std::size_t N = vec.size();
-    std::vector<std::complex<T>, Alloc> fft_vec(N, 0);
-    
-    pfft::c2c(_SHAPE(N), _CMPLX_STRIDE(T), _CMPLX_STRIDE(T), _AXIS, pfft::FORWARD,
-              vec.data(), fft_vec.data(), static_cast<T>(1.0), fft_c::nThread);
-    return fft_vec;
+    std::vector<std::complex<T>, Alloc> fft_vec(vec.get_allocator());
+    return vtool::fft_into(vec, fft_vec);
 }
 
 template <typename T, typename Alloc>
 std::vector<std::complex<T>, vtool::rebinded_alloc<Alloc, std::complex<T>>>
 fft(const std::vector<T, Alloc>& vec)
 {
-    const std::size_t N = vec.size();
     std::vector<std::complex<T>,
-                vtool::rebinded_alloc<Alloc, std::complex<T>>>
-    fft_vec = vtool::vector_cast<std::complex<T>>(vec);
+                vtool::rebinded_alloc<Alloc, std::complex<T>>> fft_vec;
 
-    pfft::c2c(_SHAPE(N), _CMPLX_STRIDE(T), _CMPLX_STRIDE(T), _AXIS, pfft::FORWARD,
-              fft_vec.data(), fft_vec.data(), static_cast<T>(1.0), fft_c::nThread);
-    return fft_vec;
+    return vtool::fft_into(vec, fft_vec);
 }
     
 template <typename T, typename Alloc>
@@ -121,58 +860,38 @@ template <typename T, typename Alloc>
 std::vector<std::complex<T>, Alloc>
 rfft(const std::vector<std::complex<T>, Alloc>& vec)
 {
-    const std::size_t N = vec.size();
-    std::vector<std::complex<T>, Alloc> fft_vec(N/2+1, 0);
-    std::vector<T, vtool::rebinded_alloc<Alloc, T>> real_vec(N, 0);
-    
-    for (std::size_t i = 0; i < N; ++i)
-        real_vec[i] = vec[i].real();
-    
-    pfft::r2c(_SHAPE(N), _REAL_STRIDE(T), _CMPLX_STRIDE(T), 0, pfft::FORWARD,
-              real_vec.data(), fft_vec.data(), static_cast<T>(1.0), fft_c::nThread);
-    return fft_vec;
+    std::vector<std::complex<T>, Alloc> fft_vec(vec.get_allocator());
+    return vtool::rfft_into(vec, fft_vec);
 }
 
 template <typename T, typename Alloc>
 std::vector<std::complex<T>, vtool::rebinded_alloc<Alloc, std::complex<T>>>
 rfft(const std::vector<T, Alloc>& vec)
 {
-    const std::size_t N = vec.size();
     std::vector<std::complex<T>,
-                vtool::rebinded_alloc<Alloc, std::complex<T>>>
-    fft_vec(N/2+1, 0);
+                vtool::rebinded_alloc<Alloc, std::complex<T>>> fft_vec;
 
-    pfft::r2c(_SHAPE(N), _REAL_STRIDE(T), _CMPLX_STRIDE(T), 0, pfft::FORWARD,
-              vec.data(), fft_vec.data(), static_cast<T>(1.0), fft_c::nThread);
-    return fft_vec;
+    return vtool::rfft_into(vec, fft_vec);
 }
 
-// ----------------------------- inverse fft ------------------------------ //
+// ------------------------------ inverse fft ----------------------------- //
 // complex to complex
 template <typename T, typename Alloc>
 std::vector<std::complex<T>, Alloc>
 ifft(const std::vector<std::complex<T>, Alloc>& vec)
 {
-    const std::size_t N = vec.size();
-    std::vector<std::complex<T>, Alloc> ifft_vec(N, 0);
-    
-    pfft::c2c(_SHAPE(N), _CMPLX_STRIDE(T), _CMPLX_STRIDE(T), _AXIS, pfft::BACKWARD,
-              vec.data(), ifft_vec.data(), static_cast<T>(1.0)/N, fft_c::nThread);
-    return ifft_vec;
+    std::vector<std::complex<T>, Alloc> ifft_vec(vec.get_allocator());
+    return vtool::ifft_into(vec, ifft_vec);
 }
 
 template <typename T, typename Alloc>
 std::vector<std::complex<T>, vtool::rebinded_alloc<Alloc, std::complex<T>>>
 ifft(const std::vector<T, Alloc>& vec)
 {
-    const std::size_t N = vec.size();
     std::vector<std::complex<T>,
-                vtool::rebinded_alloc<Alloc, std::complex<T>>>
-    ifft_vec = vtool::vector_cast<std::complex<T>>(vec);
-    
-    pfft::c2c(_SHAPE(N), _CMPLX_STRIDE(T), _CMPLX_STRIDE(T), _AXIS, pfft::BACKWARD,
-              ifft_vec.data(), ifft_vec.data(), static_cast<T>(1.0)/N, fft_c::nThread);
-    return ifft_vec;
+                vtool::rebinded_alloc<Alloc, std::complex<T>>> ifft_vec;
+
+    return vtool::ifft_into(vec, ifft_vec);
 }
 
 // complex to real
@@ -180,31 +899,1008 @@ template <typename T, typename Alloc>
 std::vector<T, vtool::rebinded_alloc<Alloc, T>>
 irfft(const std::vector<std::complex<T>, Alloc>& vec)
 {
-    const std::size_t N = vec.size();
-    std::vector<T, vtool::rebinded_alloc<Alloc, T>> ifft_vec(2*(N-1), 0);
-    
-    pfft::c2r(_SHAPE(N), _CMPLX_STRIDE(T), _REAL_STRIDE(T), 0, pfft::BACKWARD,
-              vec.data(), ifft_vec.data(), static_cast<T>(1.0)/N, fft_c::nThread);
-    return ifft_vec;
+    std::vector<T, vtool::rebinded_alloc<Alloc, T>> ifft_vec;
+    return vtool::irfft_into(vec, ifft_vec);
 }
 
 template <typename T, typename Alloc>
 std::vector<T, Alloc>
 irfft(const std::vector<T, Alloc>& vec)
 {
-    const std::size_t N = vec.size();
-    std::vector<T, Alloc> ifft_vec(N, 0);
-    
-    pfft::r2r_fftpack(_SHAPE(N), _REAL_STRIDE(T), _REAL_STRIDE(T), _AXIS, true, pfft::BACKWARD,
-                      vec.data(), ifft_vec.data(), static_cast<T>(1.0)/N, fft_c::nThread);
+    std::vector<T, Alloc> ifft_vec(vec.get_allocator());
+    return vtool::irfft_into(vec, ifft_vec);
+}
+
+// ------------------------------ vtool::view ----------------------------- //
+/* Syntax: vtool::fft_into(vtool::view vw, vtool::view<complex> out);
+ * Return: "out" holding the forward FFT of "vw".
+ */
+template <typename T>
+view<std::complex<_fft_real_t<T>>>
+fft_into(const view<T> vw, const view<std::complex<_fft_real_t<T>>> out)
+{
+    _vtool_length_check(vw, out);
+
+    vtool::_c2c(view<const typename view<T>::value_type>(vw), out,
+                pfft::FORWARD, static_cast<_fft_real_t<T>>(1.0));
+    return out;
+}
+
+/* Syntax: vtool::fft(vtool::view vw);
+ * Return: std::vector holding the forward FFT of "vw".
+ */
+template <typename T>
+std::vector<std::complex<_fft_real_t<T>>>
+fft(const view<T> vw)
+{
+    std::vector<std::complex<_fft_real_t<T>>> fft_vec(vw.size(), 0);
+    vtool::fft_into(vw, view<std::complex<_fft_real_t<T>>>(fft_vec));
+
+    return fft_vec;
+}
+
+/* Syntax: vtool::ifft_into(vtool::view vw, vtool::view<complex> out);
+ * Return: "out" holding the inverse FFT of "vw".
+ */
+template <typename T>
+view<std::complex<_fft_real_t<T>>>
+ifft_into(const view<T> vw, const view<std::complex<_fft_real_t<T>>> out)
+{
+    _vtool_length_check(vw, out);
+
+    vtool::_c2c(view<const typename view<T>::value_type>(vw), out,
+                pfft::BACKWARD, static_cast<_fft_real_t<T>>(1.0)/vw.size());
+    return out;
+}
+
+/* Syntax: vtool::ifft(vtool::view vw);
+ * Return: std::vector holding the inverse FFT of "vw".
+ */
+template <typename T>
+std::vector<std::complex<_fft_real_t<T>>>
+ifft(const view<T> vw)
+{
+    std::vector<std::complex<_fft_real_t<T>>> ifft_vec(vw.size(), 0);
+    vtool::ifft_into(vw, view<std::complex<_fft_real_t<T>>>(ifft_vec));
+
+    return ifft_vec;
+}
+
+/* Syntax: vtool::fft_inplace(vtool::view<complex> vw);
+ *         vtool::ifft_inplace(vtool::view<complex> vw);
+ * Return: "vw" holding its forward or inverse FFT.
+ */
+template <typename T>
+inline view<std::complex<T>>
+fft_inplace(const view<std::complex<T>> vw)
+{
+    return vtool::fft_into(vw, vw);
+}
+
+template <typename T>
+inline view<std::complex<T>>
+ifft_inplace(const view<std::complex<T>> vw)
+{
+    return vtool::ifft_into(vw, vw);
+}
+
+/* Syntax: vtool::rfft_into(vtool::view vw, vtool::view<complex> out);
+ * Return: "out" holding the N/2+1 non-negative frequency bins of "vw".
+ */
+template <typename T>
+view<std::complex<_fft_real_t<T>>>
+rfft_into(const view<T> vw, const view<std::complex<_fft_real_t<T>>> out)
+{
+    _vtool_size_check(out, vw.size()/2+1);
+
+    vtool::_r2c(view<const typename view<T>::value_type>(vw), out);
+    return out;
+}
+
+/* Syntax: vtool::rfft(vtool::view vw);
+ * Return: std::vector holding the N/2+1 non-negative frequency bins of "vw".
+ */
+template <typename T>
+std::vector<std::complex<_fft_real_t<T>>>
+rfft(const view<T> vw)
+{
+    std::vector<std::complex<_fft_real_t<T>>> fft_vec(vw.size()/2+1, 0);
+    vtool::rfft_into(vw, view<std::complex<_fft_real_t<T>>>(fft_vec));
+
+    return fft_vec;
+}
+
+/* Syntax: vtool::irfft_into(vtool::view vw, vtool::view<real> out);
+ * Return: "out" holding the real inverse FFT of "vw". Complex input holds
+ *         the out.size()/2+1 non-negative frequency bins.
+ */
+template <typename T>
+view<_fft_real_t<T>>
+irfft_into(const view<T> vw, const view<_fft_real_t<T>> out)
+{
+    const view<const typename view<T>::value_type> in(vw);
+    _vtool_size_check(in, vtool::_irfft_bins(in, out.size()));
+
+    vtool::_c2r(in, out);
+    return out;
+}
+
+/* Syntax: vtool::irfft(vtool::view vw);
+ * Return: std::vector holding the real inverse FFT of "vw".
+ */
+template <typename T>
+std::vector<_fft_real_t<T>>
+irfft(const view<T> vw)
+{
+    const view<const typename view<T>::value_type> in(vw);
+    std::vector<_fft_real_t<T>> ifft_vec(vtool::_irfft_size(in), 0);
+
+    vtool::_c2r(in, view<_fft_real_t<T>>(ifft_vec));
     return ifft_vec;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o ------------------ o
+    Batched Transforms
+  o ------------------ o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+/*
+ * M frames of N points stored back to back are transformed by one pocketfft
+ * call over the shape {M, N} along axis 1. A single plan serves every frame,
+ * pocketfft runs several frames at once in SIMD lanes, and batches above the
+ * parallel threshold are spread over threads.
+ */
+
+// number of whole frames of "N" points in "vw", a length error otherwise
+template <typename T>
+inline std::size_t
+_batch_count(const view<T> vw, const std::size_t N, const char* FuncName)
+{
+    return vtool::_channel_count(vw.size(), N, FuncName);
+}
+
+// byte strides between frames of "N" points and between points of a frame
+template <typename T>
+inline pfft::stride_t
+_batch_stride(const view<T> vw, const std::size_t N)
+{
+    const std::ptrdiff_t step = vw.stride() * static_cast<std::ptrdiff_t>(sizeof(T));
+    return pfft::stride_t{ static_cast<std::ptrdiff_t>(N) * step, step };
+}
+
+#define _BATCH_SHAPE(M, N) pfft::shape_t{ M, N }
+#define _BATCH_AXIS        pfft::shape_t{ 1 }
+
+// complex to complex
+template <typename T>
+void
+_batch_c2c(const view<const std::complex<T>> vw, const view<std::complex<T>> out,
+           const std::size_t N, const bool forward, const T fct, const std::size_t nThread)
+{
+    const std::size_t M = vtool::_batch_count(vw, N, __func__);
+    _vtool_length_check(vw, out);
+
+    if (M == 0)
+        return;
+    pfft::c2c(_BATCH_SHAPE(M, N), _batch_stride(vw, N), _batch_stride(out, N), _BATCH_AXIS,
+              forward, vw.data(), out.data(), fct, fft_threads::_resolve(nThread, N, M));
+}
+
+template <typename T>
+void
+_batch_c2c(const view<const T> vw, const view<std::complex<T>> out,
+           const std::size_t N, const bool forward, const T fct, const std::size_t nThread)
+{
+    vtool::vector_cast_into(vw, out);
+    vtool::_batch_c2c(view<const std::complex<T>>(out), out, N, forward, fct, nThread);
+}
+
+// real to complex
+template <typename T>
+void
+_batch_r2c(const view<const T> vw, const view<std::complex<T>> out,
+           const std::size_t N, const std::size_t nThread)
+{
+    const std::size_t M = vtool::_batch_count(vw, N, __func__);
+    _vtool_size_check(out, M*(N/2+1));
+
+    if (M == 0)
+        return;
+    pfft::r2c(_BATCH_SHAPE(M, N), _batch_stride(vw, N), _batch_stride(out, N/2+1), 1,
+              pfft::FORWARD, vw.data(), out.data(), static_cast<T>(1.0),
+              fft_threads::_resolve(nThread, N, M));
+}
+
+// complex to real
+template <typename T>
+void
+_batch_c2r(const view<const std::complex<T>> vw, const view<T> out,
+           const std::size_t N, const std::size_t nThread)
+{
+    const std::size_t M = vtool::_batch_count(out, N, __func__);
+    _vtool_size_check(vw, M*(N/2+1));
+
+    if (M == 0)
+        return;
+    pfft::c2r(_BATCH_SHAPE(M, N), _batch_stride(vw, N/2+1), _batch_stride(out, N), 1,
+              pfft::BACKWARD, vw.data(), out.data(), static_cast<T>(1.0)/N,
+              fft_threads::_resolve(nThread, N, M));
+}
+
+/* Syntax: vtool::_batch_frames<R>(std::vector<std::vector> frames, Fn fn);
+ * Return: std::vector<R> holding fn(frame) of every frame. Frames are spread
+ *         over the thread pool when their total length passes the threshold.
+ */
+template <typename R, typename Frames, typename Fn>
+std::vector<R>
+_batch_frames(const Frames& frames, const Fn& fn)
+{
+    std::vector<R> batch_vec(frames.size());
+    std::size_t total = 0;
+
+    for (std::size_t m = 0; m < frames.size(); ++m)
+        total += frames[m].size();
+
+    const std::function<void(std::size_t)> task = [&](const std::size_t m){
+        batch_vec[m] = fn(frames[m]);
+    };
+
+    if (vtool::parallel::is_parallel(total))
+        vtool::parallel::pool()->run(frames.size(), task);
+    else
+        for (std::size_t m = 0; m < frames.size(); ++m) task(m);
+
+    return batch_vec;
+}
+
+// ------------------------------ vtool::view ----------------------------- //
+/* Syntax: vtool::fft_batch_into(vtool::view vw, vtool::view<complex> out, std::size_t N,
+ *                               std::size_t nThread=0);
+ * Return: "out" holding the forward FFT of every frame of "N" points in "vw".
+ *         "nThread" 0 follows vtool::fft_threads::num_threads(), like the
+ *         "nThread" of every batched transform.
+ */
+template <typename T>
+view<std::complex<_fft_real_t<T>>>
+fft_batch_into(const view<T> vw, const view<std::complex<_fft_real_t<T>>> out,
+               const std::size_t N, const std::size_t nThread=0)
+{
+    vtool::_batch_c2c(view<const typename view<T>::value_type>(vw), out, N,
+                      pfft::FORWARD, static_cast<_fft_real_t<T>>(1.0), nThread);
+    return out;
+}
+
+/* Syntax: vtool::ifft_batch_into(vtool::view vw, vtool::view<complex> out, std::size_t N,
+ *                                std::size_t nThread=0);
+ * Return: "out" holding the inverse FFT of every frame of "N" points in "vw".
+ */
+template <typename T>
+view<std::complex<_fft_real_t<T>>>
+ifft_batch_into(const view<T> vw, const view<std::complex<_fft_real_t<T>>> out,
+                const std::size_t N, const std::size_t nThread=0)
+{
+    vtool::_batch_c2c(view<const typename view<T>::value_type>(vw), out, N,
+                      pfft::BACKWARD, static_cast<_fft_real_t<T>>(1.0)/N, nThread);
+    return out;
+}
+
+/* Syntax: vtool::rfft_batch_into(vtool::view<real> vw, vtool::view<complex> out, std::size_t N,
+ *                                std::size_t nThread=0);
+ * Return: "out" holding the N/2+1 non-negative frequency bins of every
+ *         frame of "N" samples in "vw", frame after frame.
+ */
+template <typename T>
+view<std::complex<_fft_real_t<T>>>
+rfft_batch_into(const view<T> vw, const view<std::complex<_fft_real_t<T>>> out,
+                const std::size_t N, const std::size_t nThread=0)
+{
+    vtool::_batch_r2c(view<const typename view<T>::value_type>(vw), out, N, nThread);
+    return out;
+}
+
+/* Syntax: vtool::irfft_batch_into(vtool::view<complex> vw, vtool::view<real> out, std::size_t N,
+ *                                 std::size_t nThread=0);
+ * Return: "out" holding the "N" real samples of every frame of N/2+1 bins in "vw".
+ */
+template <typename T>
+view<_fft_real_t<T>>
+irfft_batch_into(const view<T> vw, const view<_fft_real_t<T>> out, const std::size_t N,
+                 const std::size_t nThread=0)
+{
+    vtool::_batch_c2r(view<const typename view<T>::value_type>(vw), out, N, nThread);
+    return out;
+}
+
+/* Syntax: vtool::fft_batch(vtool::view vw, std::size_t N, std::size_t nThread=0);
+ *         vtool::ifft_batch, rfft_batch (same arguments);
+ * Return: std::vector holding the transform of every frame of "N" points
+ *         in "vw", frame after frame.
+ */
+template <typename T>
+std::vector<std::complex<_fft_real_t<T>>>
+fft_batch(const view<T> vw, const std::size_t N, const std::size_t nThread=0)
+{
+    std::vector<std::complex<_fft_real_t<T>>> fft_vec(vw.size(), 0);
+    vtool::fft_batch_into(vw, vtool::make_view(fft_vec), N, nThread);
+
+    return fft_vec;
+}
+
+template <typename T>
+std::vector<std::complex<_fft_real_t<T>>>
+ifft_batch(const view<T> vw, const std::size_t N, const std::size_t nThread=0)
+{
+    std::vector<std::complex<_fft_real_t<T>>> ifft_vec(vw.size(), 0);
+    vtool::ifft_batch_into(vw, vtool::make_view(ifft_vec), N, nThread);
+
+    return ifft_vec;
+}
+
+template <typename T>
+std::vector<std::complex<_fft_real_t<T>>>
+rfft_batch(const view<T> vw, const std::size_t N, const std::size_t nThread=0)
+{
+    std::vector<std::complex<_fft_real_t<T>>>
+    fft_vec(vtool::_batch_count(vw, N, __func__) * (N/2+1), 0);
+    vtool::rfft_batch_into(vw, vtool::make_view(fft_vec), N, nThread);
+
+    return fft_vec;
+}
+
+/* Syntax: vtool::irfft_batch(vtool::view<complex> vw, std::size_t N, std::size_t nThread=0);
+ * Return: std::vector holding the "N" real samples of every frame of
+ *         N/2+1 bins in "vw", frame after frame.
+ */
+template <typename T>
+std::vector<_fft_real_t<T>>
+irfft_batch(const view<T> vw, const std::size_t N, const std::size_t nThread=0)
+{
+    std::vector<_fft_real_t<T>>
+    ifft_vec(vtool::_batch_count(vw, N ? N/2+1 : 0, __func__) * N, 0);
+    vtool::irfft_batch_into(vw, vtool::make_view(ifft_vec), N, nThread);
+
+    return ifft_vec;
+}
+
+// ------------------------------ std::vector ----------------------------- //
+#define _BATCH_FUNCTION(_name, _fn)                                         \
+struct _##_name##_frame                                                     \
+{                                                                           \
+    template <typename V>                                                   \
+    auto                                                                    \
+    operator()(const V& frame) const -> decltype(vtool::_fn(frame))         \
+    { return vtool::_fn(frame); }                                           \
+};                                                                          \
+                                                                            \
+template <typename T, typename Alloc>                                       \
+inline auto                                                                 \
+_name(const std::vector<T, Alloc>& vec, const std::size_t N,                \
+      const std::size_t nThread=0)                                          \
+    -> decltype(vtool::_name(vtool::make_view(vec), N, nThread))            \
+{                                                                           \
+    return vtool::_name(vtool::make_view(vec), N, nThread);                 \
+}                                                                           \
+                                                                            \
+template <typename T, typename Alloc, typename AllocV>                      \
+inline std::vector<decltype(                                                \
+    vtool::_fn(std::declval<const std::vector<T, Alloc>&>()))>              \
+_name(const std::vector<std::vector<T, Alloc>, AllocV>& frames)             \
+{                                                                           \
+    return vtool::_batch_frames<decltype(                                   \
+        vtool::_fn(std::declval<const std::vector<T, Alloc>&>()))>(         \
+        frames, _##_name##_frame()                                          \
+    );                                                                      \
+}
+
+/* Syntax: vtool::fft_batch(std::vector vec, std::size_t N, std::size_t nThread=0);
+ *         vtool::fft_batch(std::vector<std::vector> frames);
+ *         vtool::ifft_batch, rfft_batch, irfft_batch (same arguments);
+ * Return: std::vector holding the transform of every frame of "N" points
+ *         stored back to back in "vec", or std::vector holding the transform
+ *         of every vector in "frames", each by the cached plan of its length.
+ */
+_BATCH_FUNCTION(fft_batch,   fft)
+_BATCH_FUNCTION(ifft_batch,  ifft)
+_BATCH_FUNCTION(rfft_batch,  rfft)
+_BATCH_FUNCTION(irfft_batch, irfft)
+
+#undef _BATCH_FUNCTION
+
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o ---------------------------- o
+    Short-Time Fourier Transform
+  o ---------------------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+/*
+ * A signal is cut into frames of "frame" samples, "hop" samples apart, and
+ * every frame is windowed and transformed by the real FFT of "nfft" points.
+ * The window is computed once per plan and applied while a frame is copied
+ * into its row of the output, where the FFT then runs in place, so frames
+ * need no buffer of their own. Frames are spread over threads in blocks.
+ */
+
+// ----------------------------- stft_plan<T> ----------------------------- //
+/*
+ * Forward and inverse STFT of a fixed window, frame length, hop and FFT
+ * size. The spectra of M frames are stored frame after frame, M rows of
+ * nfft/2+1 bins. The inverse is a weighted overlap-add normalized by the
+ * overlapping squared windows, which restores any signal whose samples are
+ * covered by a nonzero part of the window.
+ */
+template <typename T>
+class stft_plan
+{
+    rfft_plan<T> _plan;
+    std::vector<T> _window;
+    std::size_t _hop;
+    std::size_t _nfft;
+    std::size_t _nThread;
+
+    // runs fn(m0, m1) over blocks of the "M" frames on the resolved threads
+    template <typename Fn>
+    void
+    _blocks(const std::size_t M, const Fn& fn) const
+    {
+        const std::size_t nBlock = std::min(M, fft_threads::_resolve(_nThread, _nfft, M));
+        const std::function<void(std::size_t)> task = [&](const std::size_t b){
+            fn(M * b / nBlock, M * (b+1) / nBlock);
+        };
+
+        if (nBlock > 1 && vtool::parallel::num_threads() > 1)
+            vtool::parallel::pool()->run(nBlock, task);
+        else if (M > 0)
+            fn(0, M);
+    }
+
+  public:
+    using value_type = T;
+
+    /* "nfft" 0 is the frame length, "nThread" 0 follows
+     * vtool::fft_threads::num_threads(). The window is periodic, like the
+     * analysis windows of scipy.signal.
+     */
+    stft_plan(const windows::type win, const std::size_t frame, const std::size_t hop,
+              const std::size_t nfft=0, const std::size_t nThread=0)
+        : _plan(nfft ? nfft : frame, 1),
+          _window(windows::make<T>(win, frame, true)),
+          _hop(hop), _nfft(nfft ? nfft : frame), _nThread(nThread)
+    {
+        if (frame == 0 || hop == 0)
+            throw std::invalid_argument("Invalid Frame: frame and hop must be positive");
+        if (_nfft < frame)
+            throw std::invalid_argument("Invalid FFT Size: nfft is shorter than the frame");
+    }
+
+    inline std::size_t
+    frame() const { return _window.size(); }
+
+    inline std::size_t
+    hop() const { return _hop; }
+
+    inline std::size_t
+    nfft() const { return _nfft; }
+
+    inline std::size_t
+    bins() const { return _nfft/2+1; }
+
+    inline std::size_t
+    num_threads() const { return _nThread; }
+
+    inline const std::vector<T>&
+    window() const { return _window; }
+
+    /* Syntax: plan.frames(std::size_t N);
+     * Return: Number of whole frames in "N" samples.
+     */
+    inline std::size_t
+    frames(const std::size_t N) const
+    { return N < frame() ? 0 : (N - frame()) / _hop + 1; }
+
+    /* Syntax: plan.samples(std::size_t M);
+     * Return: Number of samples restored from "M" frames.
+     */
+    inline std::size_t
+    samples(const std::size_t M) const
+    { return M ? (M-1) * _hop + frame() : 0; }
+
+    /* Syntax: plan.execute(vtool::view<real> in, vtool::view<complex> out);
+     * Return: "out" holding the plan.bins() bins of each of the
+     *         plan.frames(in.size()) frames of "in", frame after frame.
+     */
+    template <typename U>
+    view<std::complex<T>>
+    execute(const view<U> in, const view<std::complex<T>> out) const
+    {
+        const std::size_t M = this->frames(in.size());
+        const std::size_t nBin = this->bins();
+        const std::size_t N = this->frame();
+        _vtool_size_check(out, M * nBin);
+
+        this->_blocks(M, [&](const std::size_t m0, const std::size_t m1){
+            // a strided "out" cannot hold the frame, it goes through a scratch one
+            std::vector<T> scratch(out.is_contiguous() ? 0 : _nfft);
+
+            for (std::size_t m = m0; m < m1; ++m)
+            {
+                const view<std::complex<T>> row = out.subview(m * nBin, nBin);
+                T* const buf = out.is_contiguous() ? reinterpret_cast<T*>(row.data())
+                                                   : scratch.data();
+                const view<U> seg = in.subview(m * _hop, N);
+
+                for (std::size_t n = 0; n < N; ++n)
+                    buf[n] = static_cast<T>(seg[n]) * _window[n];
+                std::fill(buf + N, buf + _nfft, static_cast<T>(0));
+
+                _plan.execute(view<const T>(buf, _nfft), row);
+            }
+        });
+        return out;
+    }
+
+    /* Syntax: plan.execute(vtool::view<complex> in, vtool::view<real> out);
+     * Return: "out" holding the plan.samples(M) samples restored from the
+     *         M frames of plan.bins() bins in "in" by overlap-add.
+     */
+    view<T>
+    execute(const view<const std::complex<T>> in, const view<T> out) const
+    {
+        const std::size_t nBin = this->bins();
+        const std::size_t M = vtool::_batch_count(in, nBin, __func__);
+        const std::size_t N = this->frame();
+        _vtool_size_check(out, this->samples(M));
+
+        // every block owns the samples from its first frame on and
+        // recomputes the earlier frames overlapping them
+        this->_blocks(M, [&](const std::size_t m0, const std::size_t m1){
+            const std::size_t first = m0 * _hop;
+            const std::size_t last = m1 == M ? out.size() : m1 * _hop;
+            const std::size_t k0 = first + _hop < N ? 0 : (first + _hop - N) / _hop;
+
+            std::vector<T> buf(_nfft);
+            std::vector<T> norm(last - first, 0);
+
+            for (std::size_t n = first; n < last; ++n)
+                out[n] = 0;
+
+            for (std::size_t m = k0; m < m1; ++m)
+            {
+                _plan.execute(in.subview(m * nBin, nBin), view<T>(buf));
+
+                const std::size_t start = m * _hop;
+                for (std::size_t n = std::max(start, first); n < std::min(start + N, last); ++n)
+                {
+                    const T w = _window[n - start];
+                    out[n] += w * buf[n - start];
+                    norm[n - first] += w * w;
+                }
+            }
+
+            // samples the windows do not reach are left unnormalized
+            for (std::size_t n = first; n < last; ++n)
+                if (norm[n - first] > std::numeric_limits<T>::epsilon())
+                    out[n] /= norm[n - first];
+        });
+        return out;
+    }
+};
+
+// ------------------------------ vtool::view ----------------------------- //
+/* Syntax: vtool::stft(vtool::view<real> vw, std::size_t frame, std::size_t hop,
+ *                     vtool::windows::type win=hanning, std::size_t nfft=0,
+ *                     std::size_t nThread=0);
+ * Return: std::vector holding the nfft/2+1 bins of every windowed frame of
+ *         "frame" samples of "vw", "hop" samples apart, frame after frame.
+ *         "nfft" 0 is the frame length.
+ */
+template <typename T>
+std::vector<std::complex<_fft_real_t<T>>>
+stft(const view<T> vw, const std::size_t frame, const std::size_t hop,
+     const windows::type win=windows::type::hanning, const std::size_t nfft=0,
+     const std::size_t nThread=0)
+{
+    const stft_plan<_fft_real_t<T>> plan(win, frame, hop, nfft, nThread);
+    std::vector<std::complex<_fft_real_t<T>>>
+    stft_vec(plan.frames(vw.size()) * plan.bins(), 0);
+
+    plan.execute(vw, vtool::make_view(stft_vec));
+    return stft_vec;
+}
+
+/* Syntax: vtool::istft(vtool::view<complex> vw, std::size_t frame, std::size_t hop,
+ *                      vtool::windows::type win=hanning, std::size_t nfft=0,
+ *                      std::size_t nThread=0);
+ * Return: std::vector holding the signal restored by overlap-add from the
+ *         frames of nfft/2+1 bins in "vw", the inverse of vtool::stft().
+ */
+template <typename T>
+std::vector<_fft_real_t<T>>
+istft(const view<T> vw, const std::size_t frame, const std::size_t hop,
+      const windows::type win=windows::type::hanning, const std::size_t nfft=0,
+      const std::size_t nThread=0)
+{
+    const stft_plan<_fft_real_t<T>> plan(win, frame, hop, nfft, nThread);
+    std::vector<_fft_real_t<T>>
+    istft_vec(plan.samples(vtool::_batch_count(vw, plan.bins(), __func__)), 0);
+
+    plan.execute(view<const typename view<T>::value_type>(vw), vtool::make_view(istft_vec));
+    return istft_vec;
+}
+
+/* Syntax: vtool::spectrogram(vtool::view<real> vw, std::size_t frame, std::size_t hop,
+ *                            vtool::windows::type win=hanning, std::size_t nfft=0,
+ *                            std::size_t nThread=0);
+ * Return: std::vector holding the squared magnitude of vtool::stft(), frame
+ *         after frame.
+ */
+template <typename T>
+std::vector<_fft_real_t<T>>
+spectrogram(const view<T> vw, const std::size_t frame, const std::size_t hop,
+            const windows::type win=windows::type::hanning, const std::size_t nfft=0,
+            const std::size_t nThread=0)
+{
+    const std::vector<std::complex<_fft_real_t<T>>>
+    stft_vec = vtool::stft(vw, frame, hop, win, nfft, nThread);
+    std::vector<_fft_real_t<T>> spec_vec(stft_vec.size());
+
+    for (std::size_t k = 0; k < stft_vec.size(); ++k)
+        spec_vec[k] = std::norm(stft_vec[k]);
+    return spec_vec;
+}
+
+// ------------------------------ std::vector ----------------------------- //
+#define _STFT_FUNCTION(_name)                                               \
+template <typename T, typename Alloc>                                       \
+inline auto                                                                 \
+_name(const std::vector<T, Alloc>& vec, const std::size_t frame,            \
+      const std::size_t hop,                                                \
+      const windows::type win=windows::type::hanning,                       \
+      const std::size_t nfft=0, const std::size_t nThread=0)                \
+    -> decltype(vtool::_name(vtool::make_view(vec), frame, hop))            \
+{                                                                           \
+    return vtool::_name(vtool::make_view(vec), frame, hop, win, nfft,       \
+                        nThread);                                           \
+}
+
+/* Syntax: vtool::stft(std::vector vec, std::size_t frame, std::size_t hop,
+ *                     vtool::windows::type win=hanning, std::size_t nfft=0,
+ *                     std::size_t nThread=0);
+ *         vtool::istft, spectrogram (same arguments);
+ * Return: Same as the vtool::view versions above.
+ */
+_STFT_FUNCTION(stft)
+_STFT_FUNCTION(istft)
+_STFT_FUNCTION(spectrogram)
+
+#undef _STFT_FUNCTION
+
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o ---------------------- o
+    Power Spectral Density
+  o ---------------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Welch's method averages the periodograms of overlapping segments. Each
+ * segment is detrended and windowed while it is copied into the buffer of
+ * its real FFT, and only the running sum of the squared magnitudes is kept,
+ * so neither segments nor spectra are stored. Segments are summed in fixed
+ * blocks of fft_c::psd_block spread over threads, and groups of
+ * fft_c::psd_group blocks are folded in order before the next group starts,
+ * so the estimate does not depend on the thread count.
+ */
+
+// trend removed from every segment before it is windowed
+enum class detrend_mode: unsigned
+{
+    none,
+    constant,   // mean of the segment
+    linear      // least squares line through the segment
+};
+
+// ----------------------------- welch_plan<T> ---------------------------- //
+/*
+ * Streaming one-sided PSD estimate by Welch's method. Chunks of any size
+ * are pushed in order, samples of a segment left incomplete by one chunk
+ * are kept for the next, and psd() returns the density of all segments
+ * completed so far in units of squared input per unit of "fs".
+ */
+template <typename T>
+class welch_plan
+{
+    rfft_plan<T> _plan;
+    std::vector<T> _window;
+    std::vector<VTOOL_DBL> _sum;    // squared magnitude per bin over all segments
+    std::vector<T> _pending;        // samples from the start of the next segment
+    std::size_t _hop;
+    std::size_t _count;
+    std::size_t _nThread;
+    detrend_mode _detrend;
+    VTOOL_DBL _fs;
+    VTOOL_DBL _scale;
+
+    // adds |rfft|^2 of the segment from sample(start) on to "acc"
+    template <typename Fn>
+    void
+    _segment(const Fn& sample, const std::size_t start, std::complex<T>* const work,
+             VTOOL_DBL* const acc) const
+    {
+        const std::size_t N = _window.size();
+        const std::size_t nfft = _plan.size();
+        const std::size_t nBin = nfft/2+1;
+        T* const buf = reinterpret_cast<T*>(work);
+
+        VTOOL_DBL mean = 0;
+        for (std::size_t n = 0; n < N; ++n)
+            mean += buf[n] = static_cast<T>(sample(start + n));
+        mean /= N;
+
+        // the line through the mean at the center n = (N-1)/2
+        const VTOOL_DBL center = static_cast<VTOOL_DBL>(N - 1) / 2;
+        VTOOL_DBL slope = 0;
+
+        if (_detrend == detrend_mode::linear && N > 1)
+        {
+            for (std::size_t n = 0; n < N; ++n)
+                slope += (n - center) * buf[n];
+            slope /= static_cast<VTOOL_DBL>(N) * (static_cast<VTOOL_DBL>(N)*N - 1) / 12;
+        }
+        if (_detrend == detrend_mode::none)
+            mean = 0;
+
+        for (std::size_t n = 0; n < N; ++n)
+            buf[n] = static_cast<T>((buf[n] - mean - slope * (n - center)) * _window[n]);
+        std::fill(buf + N, buf + nfft, static_cast<T>(0));
+
+        _plan.execute(view<const T>(buf, nfft), view<std::complex<T>>(work, nBin));
+        for (std::size_t k = 0; k < nBin; ++k)
+            acc[k] += std::norm(work[k]);
+    }
+
+    // adds the "M" segments starting at sample(m * hop)
+    template <typename Fn>
+    void
+    _accumulate(const Fn& sample, const std::size_t M)
+    {
+        const std::size_t nBin = this->bins();
+        const std::size_t nBlock = (M + fft_c::psd_block - 1) / fft_c::psd_block;
+        const std::size_t nGroup = std::min(nBlock, fft_c::psd_group);
+        const std::size_t nTask = std::min(nGroup, fft_threads::_resolve(_nThread, _plan.size(), M));
+        std::vector<VTOOL_DBL> partial(nGroup * nBin);
+        std::size_t first = 0, nPart = 0;
+
+        const std::function<void(std::size_t)> task = [&](const std::size_t t){
+            std::vector<std::complex<T>> work(nBin);
+
+            for (std::size_t b = t; b < nPart; b += nTask)
+                for (std::size_t m = (first+b) * fft_c::psd_block;
+                     m < std::min(M, (first+b+1) * fft_c::psd_block); ++m)
+                    this->_segment(sample, m * _hop, work.data(), partial.data() + b*nBin);
+        };
+
+        for (; first < nBlock; first += nGroup)
+        {
+            nPart = std::min(nGroup, nBlock - first);
+            std::fill(partial.begin(), partial.end(), 0);
+
+            if (nTask > 1 && vtool::parallel::num_threads() > 1)
+                vtool::parallel::pool()->run(nTask, task);
+            else
+                for (std::size_t t = 0; t < nTask; ++t) task(t);
+
+            // block sums of the group folded as a pairwise tree in block order
+            for (std::size_t step = 1; step < nPart; step *= 2)
+                for (std::size_t b = 0; b + step < nPart; b += 2*step)
+                    for (std::size_t k = 0; k < nBin; ++k)
+                        partial[b*nBin + k] += partial[(b+step)*nBin + k];
+
+            for (std::size_t k = 0; k < nBin; ++k)
+                _sum[k] += partial[k];
+        }
+        _count += M;
+    }
+
+  public:
+    using value_type = T;
+
+    /* "segment" samples per segment, "overlap" of them shared with the next.
+     * "nfft" 0 is the segment length, "nThread" 0 follows
+     * vtool::fft_threads::num_threads(). The window is periodic like the
+     * one of vtool::stft_plan.
+     */
+    welch_plan(const windows::type win, const std::size_t segment, const std::size_t overlap,
+               const detrend_mode detrend=detrend_mode::constant, const VTOOL_DBL fs=1,
+               const std::size_t nfft=0, const std::size_t nThread=0)
+        : _plan(nfft ? nfft : segment, 1),
+          _window(windows::make<T>(win, segment, true)),
+          _sum(_plan.size()/2+1, 0),
+          _hop(segment - overlap), _count(0), _nThread(nThread),
+          _detrend(detrend), _fs(fs), _scale(0)
+    {
+        if (segment == 0 || overlap >= segment)
+            throw std::invalid_argument("Invalid Segment: segment must be positive "
+                                        "and longer than the overlap");
+        if (_plan.size() < segment)
+            throw std::invalid_argument("Invalid FFT Size: nfft is shorter than the segment");
+        if (!(fs > 0))
+            throw std::invalid_argument("Invalid Sampling Rate: fs must be positive");
+
+        for (std::size_t n = 0; n < segment; ++n)
+            _scale += static_cast<VTOOL_DBL>(_window[n]) * _window[n];
+        _scale = 1 / (_fs * _scale);
+    }
+
+    inline std::size_t
+    segment() const { return _window.size(); }
+
+    inline std::size_t
+    hop() const { return _hop; }
+
+    inline std::size_t
+    nfft() const { return _plan.size(); }
+
+    inline std::size_t
+    bins() const { return _plan.size()/2+1; }
+
+    // number of segments averaged so far
+    inline std::size_t
+    count() const { return _count; }
+
+    /* Syntax: plan.frequencies();
+     * Return: std::vector holding the frequency of every bin of plan.psd().
+     */
+    std::vector<T>
+    frequencies() const
+    {
+        std::vector<T> freq_vec(this->bins());
+
+        for (std::size_t k = 0; k < freq_vec.size(); ++k)
+            freq_vec[k] = static_cast<T>(k * _fs / _plan.size());
+        return freq_vec;
+    }
+
+    /* Syntax: plan.push(vtool::view chunk);
+     *         plan.push(std::vector chunk);
+     * Return: Number of segments completed by "chunk" and added to the estimate.
+     */
+    template <typename U>
+    std::size_t
+    push(const view<U> chunk)
+    {
+        const std::size_t P = _pending.size();
+        const std::size_t total = P + chunk.size();
+        const std::size_t M = total < this->segment() ? 0 : (total - this->segment()) / _hop + 1;
+
+        this->_accumulate([&](const std::size_t n){
+            return n < P ? _pending[n] : static_cast<T>(chunk[n - P]);
+        }, M);
+
+        // keeps the samples from the start of the next segment on
+        const std::size_t next = M * _hop;
+
+        if (next >= total)
+            _pending.clear();
+        else if (next < P)
+        {
+            _pending.erase(_pending.begin(), _pending.begin() + next);
+            _pending.insert(_pending.end(), chunk.begin(), chunk.end());
+        }
+        else
+            _pending.assign(chunk.begin() + (next - P), chunk.end());
+
+        return M;
+    }
+
+    template <typename U, typename Alloc>
+    std::size_t
+    push(const std::vector<U, Alloc>& chunk)
+    { return this->push(vtool::make_view(chunk)); }
+
+    /* Syntax: plan.psd();
+     * Return: std::vector holding the one-sided power spectral density of
+     *         every bin, averaged over the plan.count() segments so far.
+     */
+    std::vector<T>
+    psd() const
+    {
+        std::vector<T> psd_vec(this->bins(), 0);
+
+        if (_count == 0)
+            return psd_vec;
+
+        // every bin but DC and Nyquist also holds the power of its negative frequency
+        for (std::size_t k = 0; k < psd_vec.size(); ++k)
+        {
+            const bool single = k == 0 || 2*k == _plan.size();
+            psd_vec[k] = static_cast<T>(_sum[k] * _scale / _count * (single ? 1 : 2));
+        }
+        return psd_vec;
+    }
+
+    void
+    reset()
+    {
+        std::fill(_sum.begin(), _sum.end(), 0);
+        _pending.clear();
+        _count = 0;
+    }
+};
+
+// ------------------------------ vtool::view ----------------------------- //
+/* Syntax: vtool::welch(vtool::view<real> vw, std::size_t segment, std::size_t overlap,
+ *                      vtool::windows::type win=hanning,
+ *                      vtool::detrend_mode detrend=constant, VTOOL_DBL fs=1,
+ *                      std::size_t nfft=0, std::size_t nThread=0);
+ * Return: std::vector holding the one-sided power spectral density of "vw"
+ *         sampled at "fs", averaged over its segments of "segment" samples
+ *         overlapping by "overlap", like scipy.signal.welch.
+ */
+template <typename T>
+std::vector<_fft_real_t<T>>
+welch(const view<T> vw, const std::size_t segment, const std::size_t overlap,
+      const windows::type win=windows::type::hanning,
+      const detrend_mode detrend=detrend_mode::constant, const VTOOL_DBL fs=1,
+      const std::size_t nfft=0, const std::size_t nThread=0)
+{
+    welch_plan<_fft_real_t<T>> plan(win, segment, overlap, detrend, fs, nfft, nThread);
+
+    if (plan.push(vw) == 0)
+        throw std::invalid_argument("Invalid Segment: input is shorter than one segment");
+    return plan.psd();
+}
+
+/* Syntax: vtool::periodogram(vtool::view<real> vw, vtool::windows::type win=rectangular,
+ *                            vtool::detrend_mode detrend=constant, VTOOL_DBL fs=1,
+ *                            std::size_t nfft=0);
+ * Return: std::vector holding the one-sided power spectral density of the
+ *         whole of "vw" as a single segment, like scipy.signal.periodogram.
+ */
+template <typename T>
+std::vector<_fft_real_t<T>>
+periodogram(const view<T> vw, const windows::type win=windows::type::rectangular,
+            const detrend_mode detrend=detrend_mode::constant, const VTOOL_DBL fs=1,
+            const std::size_t nfft=0)
+{
+    return vtool::welch(vw, vw.size(), 0, win, detrend, fs, nfft);
+}
+
+// ------------------------------ std::vector ----------------------------- //
+/* Syntax: vtool::welch(std::vector vec, std::size_t segment, std::size_t overlap, ...);
+ *         vtool::periodogram(std::vector vec, ...);
+ * Return: Same as the vtool::view versions above.
+ */
+template <typename T, typename Alloc>
+inline std::vector<_fft_real_t<T>>
+welch(const std::vector<T, Alloc>& vec, const std::size_t segment, const std::size_t overlap,
+      const windows::type win=windows::type::hanning,
+      const detrend_mode detrend=detrend_mode::constant, const VTOOL_DBL fs=1,
+      const std::size_t nfft=0, const std::size_t nThread=0)
+{
+    return vtool::welch(vtool::make_view(vec), segment, overlap, win, detrend, fs, nfft, nThread);
+}
+
+template <typename T, typename Alloc>
+inline std::vector<_fft_real_t<T>>
+periodogram(const std::vector<T, Alloc>& vec, const windows::type win=windows::type::rectangular,
+            const detrend_mode detrend=detrend_mode::constant, const VTOOL_DBL fs=1,
+            const std::size_t nfft=0)
+{
+    return vtool::periodogram(vtool::make_view(vec), win, detrend, fs, nfft);
+}
+
 }   // namespace vtool
 
 #undef _SHAPE
 #undef _AXIS
-#undef _REAL_STRIDE
-#undef _CMPLX_STRIDE
+#undef _VIEW_STRIDE
+#undef _BATCH_SHAPE
+#undef _BATCH_AXIS
 
 #endif  // __VTOOL_FFT_H__
\ No newline at end of file
@@ -10,17 +10,16 @@
 #define __VTOOL_OPERATOR_H__
 
 #include <vector>
+#include <utility>
 #include <algorithm>
 #include <type_traits>
 
+#include "vtool_simd.h"
+#include "vtool_view.h"
 #include "vtool_utils.h"
+#include "vtool_parallel.h"
 #include "vtool_traits.h"
-
-#ifdef NO_VECTOR_LENGTH_CHECK
-#   define _vtool_length_check(lhv, rhv)
-#else
-#   define _vtool_length_check(lhv, rhv) if (!vtool::isSameSize(lhv, rhv)) vtool::throw_vector_length_error(__func__)
-#endif
+#include "vtool_expression.h"
 
 // ------------------------------ operator+= ------------------------------ //
 // std::vector<arithmetic_type> += std::vector<arithmetic_type>
@@ -31,14 +30,8 @@ std::vector<T1, Alloc1>&
 operator+=(std::vector<T1, Alloc1>& lhv, const std::vector<T2, Alloc2>& rhv)
 {
     _vtool_length_check(lhv, rhv);
+    vtool::simd::add(lhv, rhv);
 
-    typename std::vector<T1, Alloc1>::iterator lIter = lhv.begin();
-    typename std::vector<T1, Alloc1>::const_iterator lIter_end = lhv.cend();
-    typename std::vector<T2, Alloc2>::const_iterator rIter = rhv.cbegin();
-
-    while (lIter != lIter_end)
-        *(lIter++) += *(rIter++);
-        
     return lhv;
 }
 
@@ -51,6 +44,35 @@ operator+=(std::vector<T1, Alloc1>&& lhv, const std::vector<T2, Alloc2>& rhv)
     return static_cast<std::vector<T1, Alloc1>&>(lhv) += rhv;
 }
 
+// std::vector<arithmetic_type> += vtool::vector_expression
+template <typename T1, typename Alloc1, typename E,
+          typename vtool::is_arithmetic<T1>::type = true>
+_CXX20_CONSTEXPR
+std::vector<T1, Alloc1>&
+operator+=(std::vector<T1, Alloc1>& lhv, const vtool::vector_expression<E>& rhv)
+{
+    _vtool_length_check(lhv, rhv.derived());
+
+    const E& expr = rhv.derived();
+    T1* const data = lhv.data();
+
+    vtool::parallel::for_each_range(lhv.size(), sizeof(T1),
+        [&](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n) data[n] += expr[n];
+        });
+
+    return lhv;
+}
+
+template <typename T1, typename Alloc1, typename E,
+          typename vtool::is_arithmetic<T1>::type = true>
+_CXX20_CONSTEXPR
+inline std::vector<T1, Alloc1>&
+operator+=(std::vector<T1, Alloc1>&& lhv, const vtool::vector_expression<E>& rhv)
+{
+    return static_cast<std::vector<T1, Alloc1>&>(lhv) += rhv;
+}
+
 // std::vector<arithmetic_type> += arithmetic_type
 template <typename T1, typename T2, typename Alloc1,
           typename vtool::is_arithmetic<T1, T2>::type = true>
@@ -58,7 +80,12 @@ _CXX20_CONSTEXPR
 std::vector<T1, Alloc1>&
 operator+=(std::vector<T1, Alloc1>& lhv, const T2 rhs)
 {
-    for (T1& value: lhv) value += rhs;
+    T1* const data = lhv.data();
+
+    vtool::parallel::for_each_range(lhv.size(), sizeof(T1),
+        [=](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n) data[n] += rhs;
+        });
     return lhv;
 }
 
@@ -80,13 +107,7 @@ std::vector<T1, Alloc1>&
 operator-=(std::vector<T1, Alloc1>& lhv, const std::vector<T2, Alloc2>& rhv)
 {
     _vtool_length_check(lhv, rhv);
-
-    typename std::vector<T1, Alloc1>::iterator lIter = lhv.begin();
-    typename std::vector<T1, Alloc1>::const_iterator lIter_end = lhv.cend();
-    typename std::vector<T2, Alloc2>::const_iterator rIter = rhv.cbegin();
-
-    while (lIter != lIter_end)
-        *(lIter++) -= *(rIter++);
+    vtool::simd::sub(lhv, rhv);
 
     return lhv;
 }
@@ -100,6 +121,35 @@ operator-=(std::vector<T1, Alloc1>&& lhv, const std::vector<T2, Alloc2>& rhv)
     return static_cast<std::vector<T1>&>(lhv) -= rhv;
 }
 
+// std::vector<arithmetic_type> -= vtool::vector_expression
+template <typename T1, typename Alloc1, typename E,
+          typename vtool::is_arithmetic<T1>::type = true>
+_CXX20_CONSTEXPR
+std::vector<T1, Alloc1>&
+operator-=(std::vector<T1, Alloc1>& lhv, const vtool::vector_expression<E>& rhv)
+{
+    _vtool_length_check(lhv, rhv.derived());
+
+    const E& expr = rhv.derived();
+    T1* const data = lhv.data();
+
+    vtool::parallel::for_each_range(lhv.size(), sizeof(T1),
+        [&](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n) data[n] -= expr[n];
+        });
+
+    return lhv;
+}
+
+template <typename T1, typename Alloc1, typename E,
+          typename vtool::is_arithmetic<T1>::type = true>
+_CXX20_CONSTEXPR
+inline std::vector<T1, Alloc1>&
+operator-=(std::vector<T1, Alloc1>&& lhv, const vtool::vector_expression<E>& rhv)
+{
+    return static_cast<std::vector<T1, Alloc1>&>(lhv) -= rhv;
+}
+
 // std::vector<arithmetic_type> -= arithmetic_type
 template <typename T1, typename T2, typename Alloc1,
           typename vtool::is_arithmetic<T1, T2>::type = true>
@@ -107,7 +157,12 @@ _CXX20_CONSTEXPR
 std::vector<T1, Alloc1>&
 operator-=(std::vector<T1, Alloc1>& lhv, const T2 rhs)
 {
-    for (T1& value: lhv) value -= rhs;
+    T1* const data = lhv.data();
+
+    vtool::parallel::for_each_range(lhv.size(), sizeof(T1),
+        [=](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n) data[n] -= rhs;
+        });
     return lhv;
 }
 
@@ -129,14 +184,8 @@ std::vector<T1, Alloc1>&
 operator*=(std::vector<T1, Alloc1>& lhv, const std::vector<T2, Alloc2>& rhv)
 {
     _vtool_length_check(lhv, rhv);
+    vtool::simd::mul(lhv, rhv);
 
-    typename std::vector<T1, Alloc1>::iterator lIter = lhv.begin();
-    typename std::vector<T1, Alloc1>::const_iterator lIter_end = lhv.cend();
-    typename std::vector<T2, Alloc2>::const_iterator rIter = rhv.cbegin();
-
-    while (lIter != lIter_end)
-        *(lIter++) *= *(rIter++);
-        
     return lhv;
 }
 
@@ -149,6 +198,35 @@ operator*=(std::vector<T1, Alloc1>&& lhv, const std::vector<T2, Alloc2>& rhv)
     return static_cast<std::vector<T1, Alloc1>&>(lhv) *= rhv;
 }
 
+// std::vector<arithmetic_type> *= vtool::vector_expression
+template <typename T1, typename Alloc1, typename E,
+          typename vtool::is_arithmetic<T1>::type = true>
+_CXX20_CONSTEXPR
+std::vector<T1, Alloc1>&
+operator*=(std::vector<T1, Alloc1>& lhv, const vtool::vector_expression<E>& rhv)
+{
+    _vtool_length_check(lhv, rhv.derived());
+
+    const E& expr = rhv.derived();
+    T1* const data = lhv.data();
+
+    vtool::parallel::for_each_range(lhv.size(), sizeof(T1),
+        [&](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n) data[n] *= expr[n];
+        });
+
+    return lhv;
+}
+
+template <typename T1, typename Alloc1, typename E,
+          typename vtool::is_arithmetic<T1>::type = true>
+_CXX20_CONSTEXPR
+inline std::vector<T1, Alloc1>&
+operator*=(std::vector<T1, Alloc1>&& lhv, const vtool::vector_expression<E>& rhv)
+{
+    return static_cast<std::vector<T1, Alloc1>&>(lhv) *= rhv;
+}
+
 // std::vector<arithmetic_type> *= arithmetic_type
 template <typename T1, typename T2, typename Alloc1,
           typename vtool::is_arithmetic<T1, T2>::type = true>
@@ -156,7 +234,12 @@ _CXX20_CONSTEXPR
 std::vector<T1, Alloc1>&
 operator*=(std::vector<T1, Alloc1>& lhv, const T2 rhs)
 {
-    for (T1& value: lhv) value *= rhs;
+    T1* const data = lhv.data();
+
+    vtool::parallel::for_each_range(lhv.size(), sizeof(T1),
+        [=](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n) data[n] *= rhs;
+        });
     return lhv;
 }
 
@@ -178,14 +261,8 @@ std::vector<T1, Alloc1>&
 operator/=(std::vector<T1, Alloc1>& lhv, const std::vector<T2, Alloc2>& rhv)
 {
     _vtool_length_check(lhv, rhv);
+    vtool::simd::div(lhv, rhv);
 
-    typename std::vector<T1, Alloc1>::iterator lIter = lhv.begin();
-    typename std::vector<T1, Alloc1>::const_iterator lIter_end = lhv.cend();
-    typename std::vector<T2, Alloc2>::const_iterator rIter = rhv.cbegin();
-
-    while (lIter != lIter_end)
-        *(lIter++) /= *(rIter++);
-        
     return lhv;
 }
 
@@ -198,6 +275,35 @@ operator/=(std::vector<T1, Alloc1>&& lhv, const std::vector<T2, Alloc2>& rhv)
     return static_cast<std::vector<T1, Alloc1>&>(lhv) /= rhv;
 }
 
+// std::vector<arithmetic_type> /= vtool::vector_expression
+template <typename T1, typename Alloc1, typename E,
+          typename vtool::is_arithmetic<T1>::type = true>
+_CXX20_CONSTEXPR
+std::vector<T1, Alloc1>&
+operator/=(std::vector<T1, Alloc1>& lhv, const vtool::vector_expression<E>& rhv)
+{
+    _vtool_length_check(lhv, rhv.derived());
+
+    const E& expr = rhv.derived();
+    T1* const data = lhv.data();
+
+    vtool::parallel::for_each_range(lhv.size(), sizeof(T1),
+        [&](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n) data[n] /= expr[n];
+        });
+
+    return lhv;
+}
+
+template <typename T1, typename Alloc1, typename E,
+          typename vtool::is_arithmetic<T1>::type = true>
+_CXX20_CONSTEXPR
+inline std::vector<T1, Alloc1>&
+operator/=(std::vector<T1, Alloc1>&& lhv, const vtool::vector_expression<E>& rhv)
+{
+    return static_cast<std::vector<T1, Alloc1>&>(lhv) /= rhv;
+}
+
 // std::vector<arithmetic_type> /= arithmetic_type
 template <typename T1, typename T2, typename Alloc1,
           typename vtool::is_arithmetic<T1, T2>::type = true>
@@ -205,7 +311,12 @@ _CXX20_CONSTEXPR
 std::vector<T1, Alloc1>&
 operator/=(std::vector<T1, Alloc1>& lhv, const T2 rhs)
 {
-    for (T1& value: lhv) value /= rhs;
+    T1* const data = lhv.data();
+
+    vtool::parallel::for_each_range(lhv.size(), sizeof(T1),
+        [=](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n) data[n] /= rhs;
+        });
     return lhv;
 }
 
@@ -218,6 +329,63 @@ operator/=(std::vector<T1, Alloc1>&& lhv, const T2 rhs)
     return static_cast<std::vector<T1, Alloc1>&>(lhv) /= rhs;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o --------------------------------------------- o
+    Compound Assignment Operators for vtool::view
+  o --------------------------------------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+/*
+ * A writable view is updated in place through its borrowed buffer, and
+ * a view may appear on the right side of any compound assignment.
+ */
+#define _VTOOL_VIEW_COMPOUND_OPERATOR(_op, _Op)                             \
+template <typename T, typename R,                                           \
+          typename std::enable_if<!std::is_const<T>::value, bool>::type = true,\
+          typename vtool::is_expression_operands<vtool::view<T>, R>::type = true>\
+inline vtool::view<T>                                                       \
+operator _op##=(const vtool::view<T>& lhv, const R& rhv)                    \
+{                                                                           \
+    _vtool_length_check(lhv, rhv);                                          \
+    vtool::_compound_assign<_Op>(lhv, rhv);                                 \
+    return lhv;                                                             \
+}                                                                           \
+                                                                            \
+template <typename T1, typename T2, typename Alloc1,                        \
+          typename vtool::is_arithmetic<                                    \
+              T1, typename vtool::view<T2>::value_type>::type = true>       \
+inline std::vector<T1, Alloc1>&                                             \
+operator _op##=(std::vector<T1, Alloc1>& lhv, const vtool::view<T2>& rhv)   \
+{                                                                           \
+    _vtool_length_check(lhv, rhv);                                          \
+    vtool::_compound_assign<_Op>(vtool::view<T1>(lhv), rhv);                \
+    return lhv;                                                             \
+}
+
+// --------------------------- operator+= (view) -------------------------- //
+// vtool::view<arithmetic_type> += (any operand)
+// std::vector<arithmetic_type> += vtool::view<arithmetic_type>
+_VTOOL_VIEW_COMPOUND_OPERATOR(+, vtool::_plus)
+
+// --------------------------- operator-= (view) -------------------------- //
+// vtool::view<arithmetic_type> -= (any operand)
+// std::vector<arithmetic_type> -= vtool::view<arithmetic_type>
+_VTOOL_VIEW_COMPOUND_OPERATOR(-, vtool::_minus)
+
+// --------------------------- operator*= (view) -------------------------- //
+// vtool::view<arithmetic_type> *= (any operand)
+// std::vector<arithmetic_type> *= vtool::view<arithmetic_type>
+_VTOOL_VIEW_COMPOUND_OPERATOR(*, vtool::_multiplies)
+
+// --------------------------- operator/= (view) -------------------------- //
+// vtool::view<arithmetic_type> /= (any operand)
+// std::vector<arithmetic_type> /= vtool::view<arithmetic_type>
+_VTOOL_VIEW_COMPOUND_OPERATOR(/, vtool::_divides)
+
+#undef _VTOOL_VIEW_COMPOUND_OPERATOR
+
 //////////////////////////////////////////////////////////////////////////////
 /*
   o ------------------------------------------------------- o
@@ -226,162 +394,179 @@ operator/=(std::vector<T1, Alloc1>&& lhv, const T2 rhs)
 */
 //////////////////////////////////////////////////////////////////////////////
 
+/*
+ * Binary operators build a lazy vtool::binary_expression instead of a vector.
+ * The operands may be std::vector<arithmetic_type>, arithmetic_type or another
+ * expression, so a chain like "a*b + c*d - e" is computed in one fused loop
+ * when it is assigned to a std::vector (or passed to vtool::eval).
+ */
+
 // ------------------------------- operator+ ------------------------------ //
 // std::vector<arithmetic_type> + std::vector<arithmetic_type>
-template <typename T1, typename T2, typename Alloc1, typename Alloc2,
-          typename vtool::is_arithmetic<T1, T2>::type = true>
-_CXX20_CONSTEXPR
-inline vtool::decltype_vector_t<T1, T2, Alloc1, Alloc2>
-operator+(const std::vector<T1, Alloc1>& lhv, const std::vector<T2, Alloc2>& rhv)
-{
-    return vtool::decltype_vector_t<T1, T2, Alloc1, Alloc2>
-          (lhv.cbegin(), lhv.cend()) += rhv;
-}
-
 // std::vector<arithmetic_type> + arithmetic_type
-template <typename T1, typename T2, typename Alloc1,
-          typename vtool::is_arithmetic<T1, T2>::type = true>
-_CXX20_CONSTEXPR
-inline vtool::decltype_vector_t<T1, T2, Alloc1,
-                                vtool::rebinded_alloc<Alloc1, T2>>
-operator+(const std::vector<T1, Alloc1>& lhv, const T2 rhs)
-{
-    return vtool::decltype_vector_t<T1, T2, Alloc1,
-                                    vtool::rebinded_alloc<Alloc1, T2>>
-          (lhv.cbegin(), lhv.cend()) += rhs;
-}
-
 // arithmetic_type + std::vector<arithmetic_type>
-template <typename T1, typename T2, typename Alloc2,
-          typename vtool::is_arithmetic<T1, T2>::type = true>
+// (any of above) + vtool::vector_expression
+template <typename L, typename R,
+          typename vtool::is_expression_operands<L, R>::type = true>
 _CXX20_CONSTEXPR
-inline vtool::decltype_vector_t<T1, T2,
-                                vtool::rebinded_alloc<Alloc2, T1>, Alloc2>
-operator+(const T1 lhs, const std::vector<T2, Alloc2>& rhv)
+inline vtool::binary_expression<vtool::_plus, L, R>
+operator+(const L& lhv, const R& rhv)
 {
-    using vType = vtool::decltype_vector_t<T1, T2,
-                                           vtool::rebinded_alloc<Alloc2, T1>, Alloc2>;
-    return vType(rhv.size(),
-                 static_cast<typename vType::value_type>(lhs)) += rhv;
+    _vtool_length_check(lhv, rhv);
+    return vtool::make_binary_expression<vtool::_plus>(lhv, rhv);
 }
 
 // ------------------------------- operator- ------------------------------ //
 // std::vector<arithmetic_type> - std::vector<arithmetic_type>
-template <typename T1, typename T2, typename Alloc1, typename Alloc2,
-          typename vtool::is_arithmetic<T1, T2>::type = true>
-_CXX20_CONSTEXPR
-inline vtool::decltype_vector_t<T1, T2, Alloc1, Alloc2>
-operator-(const std::vector<T1, Alloc1>& lhv, const std::vector<T2, Alloc2>& rhv)
-{
-    return vtool::decltype_vector_t<T1, T2, Alloc1, Alloc2>
-          (lhv.cbegin(), lhv.cend()) -= rhv;
-}
-
 // std::vector<arithmetic_type> - arithmetic_type
-template <typename T1, typename T2, typename Alloc1,
-          typename vtool::is_arithmetic<T1, T2>::type = true>
-_CXX20_CONSTEXPR
-inline vtool::decltype_vector_t<T1, T2, Alloc1,
-                                    vtool::rebinded_alloc<Alloc1, T2>>
-operator-(const std::vector<T1, Alloc1>& lhv, const T2 rhs)
-{
-    return vtool::decltype_vector_t<T1, T2, Alloc1,
-                                    vtool::rebinded_alloc<Alloc1, T2>>
-          (lhv.cbegin(), lhv.cend()) -= rhs;
-}
-
 // arithmetic_type - std::vector<arithmetic_type>
-template <typename T1, typename T2, typename Alloc2,
-          typename vtool::is_arithmetic<T1, T2>::type = true>
+// (any of above) - vtool::vector_expression
+template <typename L, typename R,
+          typename vtool::is_expression_operands<L, R>::type = true>
 _CXX20_CONSTEXPR
-inline vtool::decltype_vector_t<T1, T2,
-                                vtool::rebinded_alloc<Alloc2, T1>, Alloc2>
-operator-(const T1 lhs, const std::vector<T2, Alloc2>& rhv)
+inline vtool::binary_expression<vtool::_minus, L, R>
+operator-(const L& lhv, const R& rhv)
 {
-    using vType = vtool::decltype_vector_t<T1, T2,
-                                           vtool::rebinded_alloc<Alloc2, T1>, Alloc2>;
-    return vType(rhv.size(),
-                 static_cast<typename vType::value_type>(lhs)) -= rhv;
+    _vtool_length_check(lhv, rhv);
+    return vtool::make_binary_expression<vtool::_minus>(lhv, rhv);
 }
 
 // ------------------------------- operator* ------------------------------ //
 // std::vector<arithmetic_type> * std::vector<arithmetic_type>
-template <typename T1, typename T2, typename Alloc1, typename Alloc2,
-          typename vtool::is_arithmetic<T1, T2>::type = true>
-_CXX20_CONSTEXPR
-inline vtool::decltype_vector_t<T1, T2, Alloc1, Alloc2>
-operator*(const std::vector<T1, Alloc1>& lhv, const std::vector<T2, Alloc2>& rhv)
-{
-    return vtool::decltype_vector_t<T1, T2, Alloc1, Alloc2>
-          (lhv.cbegin(), lhv.cend()) *= rhv;
-}
-
 // std::vector<arithmetic_type> * arithmetic_type
-template <typename T1, typename T2, typename Alloc1,
-          typename vtool::is_arithmetic<T1, T2>::type = true>
-_CXX20_CONSTEXPR
-inline vtool::decltype_vector_t<T1, T2, Alloc1,
-                                    vtool::rebinded_alloc<Alloc1, T2>>
-operator*(const std::vector<T1, Alloc1>& lhv, const T2 rhs)
-{
-    return vtool::decltype_vector_t<T1, T2, Alloc1,
-                                    vtool::rebinded_alloc<Alloc1, T2>>
-          (lhv.cbegin(), lhv.cend()) *= rhs;
-}
-
 // arithmetic_type * std::vector<arithmetic_type>
-template <typename T1, typename T2, typename Alloc2,
-          typename vtool::is_arithmetic<T1, T2>::type = true>
+// (any of above) * vtool::vector_expression
+template <typename L, typename R,
+          typename vtool::is_expression_operands<L, R>::type = true>
 _CXX20_CONSTEXPR
-inline vtool::decltype_vector_t<T1, T2,
-                                vtool::rebinded_alloc<Alloc2, T1>, Alloc2>
-operator*(const T1 lhs, const std::vector<T2, Alloc2>& rhv)
+inline vtool::binary_expression<vtool::_multiplies, L, R>
+operator*(const L& lhv, const R& rhv)
 {
-    using vType = vtool::decltype_vector_t<T1, T2,
-                                           vtool::rebinded_alloc<Alloc2, T1>, Alloc2>;
-    return vType(rhv.size(),
-                 static_cast<typename vType::value_type>(lhs)) *= rhv;
+    _vtool_length_check(lhv, rhv);
+    return vtool::make_binary_expression<vtool::_multiplies>(lhv, rhv);
 }
 
 // ------------------------------- operator/ ------------------------------ //
 // std::vector<arithmetic_type> / std::vector<arithmetic_type>
-template <typename T1, typename T2, typename Alloc1, typename Alloc2,
-          typename vtool::is_arithmetic<T1, T2>::type = true>
-_CXX20_CONSTEXPR
-inline vtool::decltype_vector_t<T1, T2, Alloc1, Alloc2>
-operator/(const std::vector<T1, Alloc1>& lhv, const std::vector<T2, Alloc2>& rhv)
-{
-    return vtool::decltype_vector_t<T1, T2, Alloc1, Alloc2>
-          (lhv.cbegin(), lhv.cend()) /= rhv;
-}
-
 // std::vector<arithmetic_type> / arithmetic_type
-template <typename T1, typename T2, typename Alloc1,
-          typename vtool::is_arithmetic<T1, T2>::type = true>
+// arithmetic_type / std::vector<arithmetic_type>
+// (any of above) / vtool::vector_expression
+template <typename L, typename R,
+          typename vtool::is_expression_operands<L, R>::type = true>
 _CXX20_CONSTEXPR
-inline vtool::decltype_vector_t<T1, T2, Alloc1,
-                                vtool::rebinded_alloc<Alloc1, T2>>
-operator/(const std::vector<T1, Alloc1>& lhv, const T2 rhs)
+inline vtool::binary_expression<vtool::_divides, L, R>
+operator/(const L& lhv, const R& rhv)
 {
-    return vtool::decltype_vector_t<T1, T2, Alloc1,
-                                    vtool::rebinded_alloc<Alloc1, T2>>
-          (lhv.cbegin(), lhv.cend()) /= rhs;
+    _vtool_length_check(lhv, rhv);
+    return vtool::make_binary_expression<vtool::_divides>(lhv, rhv);
 }
 
-// arithmetic_type / std::vector<arithmetic_type>
-template <typename T1, typename T2, typename Alloc2,
-          typename vtool::is_arithmetic<T1, T2>::type = true>
-_CXX20_CONSTEXPR
-inline vtool::decltype_vector_t<T1, T2,
-                                vtool::rebinded_alloc<Alloc2, T1>, Alloc2>
-operator/(const T1 lhs, const std::vector<T2, Alloc2>& rhv)
-{
-    using vType = vtool::decltype_vector_t<T1, T2,
-                                           vtool::rebinded_alloc<Alloc2, T1>, Alloc2>;
-    return vType(rhv.size(),
-                 static_cast<typename vType::value_type>(lhs)) /= rhv;
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o --------------------------------------------------------- o
+    Storage Reusing Binary Operators for expiring std::vector
+  o --------------------------------------------------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+/*
+ * When an operand is an expiring std::vector whose value_type and allocator
+ * already match the result, the result is computed in place into that
+ * operand and returned by move, so no new buffer is allocated.
+ * Otherwise the expiring vector is moved into the lazy expression, so an
+ * expression kept in "auto" never refers to a destroyed temporary. Expiring
+ * expressions are moved into the node built from them as well, so a chain
+ * never copies its operands.
+ */
+#define _VTOOL_REUSING_OPERATOR(_op, _Op)                                   \
+template <typename T, typename Alloc, typename R,                           \
+          typename vtool::is_result_storage<                                \
+              std::vector<T, Alloc>, std::vector<T, Alloc>, R>::type = true>\
+inline std::vector<T, Alloc>                                                \
+operator _op(std::vector<T, Alloc>&& lhv, const R& rhv)                     \
+{                                                                           \
+    _vtool_length_check(lhv, rhv);                                          \
+    lhv _op##= rhv;                                                         \
+    return std::move(lhv);                                                  \
+}                                                                           \
+                                                                            \
+template <typename L, typename T, typename Alloc,                           \
+          typename vtool::is_right_storage<                                 \
+              L, std::vector<T, Alloc>>::type = true>                       \
+inline std::vector<T, Alloc>                                                \
+operator _op(L&& lhv, std::vector<T, Alloc>&& rhv)                          \
+{                                                                           \
+    _vtool_length_check(lhv, rhv);                                          \
+    vtool::_assign_from_left<_Op>(                                          \
+        static_cast<const typename std::decay<L>::type&>(lhv), rhv);        \
+    return std::move(rhv);                                                  \
+}                                                                           \
+                                                                            \
+template <typename T, typename Alloc, typename R,                           \
+          typename vtool::is_owned_left<                                    \
+              std::vector<T, Alloc>, R>::type = true>                       \
+inline vtool::binary_expression<_Op, std::vector<T, Alloc>&&, R>            \
+operator _op(std::vector<T, Alloc>&& lhv, const R& rhv)                     \
+{                                                                           \
+    _vtool_length_check(lhv, rhv);                                          \
+    return vtool::binary_expression<_Op, std::vector<T, Alloc>&&, R>(       \
+        lhv, rhv                                                            \
+    );                                                                      \
+}                                                                           \
+                                                                            \
+template <typename L, typename T, typename Alloc,                           \
+          typename vtool::is_owned_right<                                   \
+              L, std::vector<T, Alloc>>::type = true>                       \
+inline vtool::binary_expression<                                            \
+    _Op, vtool::_expression_arg_t<L>, std::vector<T, Alloc>&&>              \
+operator _op(L&& lhv, std::vector<T, Alloc>&& rhv)                          \
+{                                                                           \
+    _vtool_length_check(lhv, rhv);                                          \
+    return vtool::binary_expression<                                        \
+        _Op, vtool::_expression_arg_t<L>, std::vector<T, Alloc>&&>(         \
+        std::forward<L>(lhv), rhv                                           \
+    );                                                                      \
+}                                                                           \
+                                                                            \
+template <typename L, typename R,                                           \
+          typename vtool::is_forwarded_operands<L, R>::type = true>         \
+inline vtool::binary_expression<                                            \
+    _Op, vtool::_expression_arg_t<L>, vtool::_expression_arg_t<R>>          \
+operator _op(L&& lhv, R&& rhv)                                              \
+{                                                                           \
+    _vtool_length_check(lhv, rhv);                                          \
+    return vtool::binary_expression<                                        \
+        _Op, vtool::_expression_arg_t<L>, vtool::_expression_arg_t<R>>(     \
+        std::forward<L>(lhv), std::forward<R>(rhv)                          \
+    );                                                                      \
 }
 
+// ---------------------------- operator+ (&&) ---------------------------- //
+// std::vector<arithmetic_type>&& + (any operand)
+// (any operand) + std::vector<arithmetic_type>&&
+// vtool::vector_expression&& + (any operand), and the reverse
+_VTOOL_REUSING_OPERATOR(+, vtool::_plus)
+
+// ---------------------------- operator- (&&) ---------------------------- //
+// std::vector<arithmetic_type>&& - (any operand)
+// (any operand) - std::vector<arithmetic_type>&&
+// vtool::vector_expression&& - (any operand), and the reverse
+_VTOOL_REUSING_OPERATOR(-, vtool::_minus)
+
+// ---------------------------- operator* (&&) ---------------------------- //
+// std::vector<arithmetic_type>&& * (any operand)
+// (any operand) * std::vector<arithmetic_type>&&
+// vtool::vector_expression&& * (any operand), and the reverse
+_VTOOL_REUSING_OPERATOR(*, vtool::_multiplies)
+
+// ---------------------------- operator/ (&&) ---------------------------- //
+// std::vector<arithmetic_type>&& / (any operand)
+// (any operand) / std::vector<arithmetic_type>&&
+// vtool::vector_expression&& / (any operand), and the reverse
+_VTOOL_REUSING_OPERATOR(/, vtool::_divides)
+
+#undef _VTOOL_REUSING_OPERATOR
+
 #include <iostream>
 // ------------------------------ operator<< ------------------------------ //
 template <typename T, typename Alloc>
@@ -392,6 +577,23 @@ operator<<(std::ostream& out, const std::vector<T, Alloc>& vec)
     return out;
 }
 
-#undef _vtool_length_check
+template <typename T>
+std::ostream&
+operator<<(std::ostream& out, const vtool::view<T>& vw)
+{
+    for (const T& value: vw) out << value << "\t";
+    return out;
+}
+
+template <typename E>
+std::ostream&
+operator<<(std::ostream& out, const vtool::vector_expression<E>& expr)
+{
+    const E& derived = expr.derived();
+    const std::size_t N = derived.size();
+
+    for (std::size_t n = 0; n < N; ++n) out << derived[n] << "\t";
+    return out;
+}
 
 #endif  // __VTOOL_OPERATOR_H__
\ No newline at end of file
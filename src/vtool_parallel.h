@@ -0,0 +1,375 @@
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o ---------------------------------------- o
+    Shared Thread Pool for Element-wise Work
+  o ---------------------------------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VTOOL_PARALLEL_H__
+#define __VTOOL_PARALLEL_H__
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <exception>
+#include <algorithm>
+#include <functional>
+#include <condition_variable>
+
+namespace vtool {
+    namespace parallel {
+
+    namespace parallel_c
+    {
+        static const bool
+        enabled
+#if defined(USE_PARALLEL_EXECUTION) || defined(USE_DEFAULT_MULTITHREADING)
+        = true;
+#else
+        = false;
+#endif
+
+        // vectors shorter than this stay on the calling thread
+        static const std::size_t
+        threshold = std::size_t(1) << 18;
+
+        // bytes of one operand handled by a single task
+        static const std::size_t
+        chunk_bytes = std::size_t(1) << 16;
+    }
+
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o ----------- o
+    Thread Pool
+  o ----------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+inline bool&
+_in_worker()
+{
+    static thread_local bool in_worker = false;
+    return in_worker;
+}
+
+// marks the calling thread as running tasks of the pool while it is alive
+class _worker_scope
+{
+    bool _was;
+
+  public:
+    _worker_scope(): _was(_in_worker()) { _in_worker() = true; }
+    ~_worker_scope() { _in_worker() = _was; }
+
+    _worker_scope(const _worker_scope&) = delete;
+    _worker_scope& operator=(const _worker_scope&) = delete;
+};
+
+// ------------------------------ thread_pool ----------------------------- //
+/*
+ * Fixed set of worker threads running one batch of indexed tasks at a time.
+ * The calling thread takes tasks too, so a pool of size N owns N-1 threads.
+ * Calls from inside a task, or while another thread is running a batch,
+ * execute serially instead of waiting.
+ */
+class thread_pool
+{
+    std::vector<std::thread> _workers;
+
+    std::mutex _run_mutex;
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _done;
+
+    const std::function<void(std::size_t)>* _task;
+    std::size_t _nTask;
+    std::atomic<std::size_t> _next;
+    std::size_t _active;
+    std::size_t _generation;
+    bool _stop;
+    std::exception_ptr _error;
+
+    void
+    _drain()
+    {
+        for (std::size_t n = _next.fetch_add(1); n < _nTask; n = _next.fetch_add(1))
+        {
+            try { (*_task)(n); }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (!_error) _error = std::current_exception();
+            }
+        }
+    }
+
+    void
+    _work()
+    {
+        _in_worker() = true;
+        std::size_t seen = 0;
+
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _wake.wait(lock, [&]{ return _stop || _generation != seen; });
+
+                if (_stop) return;
+                seen = _generation;
+            }
+            _drain();
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (--_active == 0) _done.notify_one();
+            }
+        }
+    }
+
+  public:
+    explicit thread_pool(const std::size_t nThread)
+        : _task(nullptr), _nTask(0), _next(0),
+          _active(0), _generation(0), _stop(false)
+    {
+        for (std::size_t n = 1; n < nThread; ++n)
+            _workers.emplace_back(&thread_pool::_work, this);
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    ~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _wake.notify_all();
+
+        for (std::thread& worker: _workers)
+            worker.join();
+    }
+
+    inline std::size_t
+    size() const
+    { return _workers.size() + 1; }
+
+    /* Syntax: pool.run(std::size_t nTask, std::function<void(std::size_t)> task);
+     * Return: None. Calls task(0) ... task(nTask-1) across the pool and
+     *         rethrows the first exception raised by a task.
+     */
+    void
+    run(const std::size_t nTask, const std::function<void(std::size_t)>& task)
+    {
+        if (_workers.empty() || nTask < 2 || _in_worker())
+        {
+            for (std::size_t n = 0; n < nTask; ++n) task(n);
+            return;
+        }
+
+        std::unique_lock<std::mutex> run_lock(_run_mutex, std::try_to_lock);
+
+        if (!run_lock.owns_lock())
+        {
+            for (std::size_t n = 0; n < nTask; ++n) task(n);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _task   = &task;
+            _nTask  = nTask;
+            _next   = 0;
+            _active = _workers.size();
+            _error  = nullptr;
+            ++_generation;
+        }
+        _wake.notify_all();
+        {
+            // nested vtool calls of a task run serially here, as on the workers
+            const _worker_scope scope;
+            _drain();
+        }
+
+        std::exception_ptr error;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _done.wait(lock, [&]{ return _active == 0; });
+
+            _task = nullptr;
+            error = _error;
+        }
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o ---------------- o
+    Runtime Settings
+  o ---------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+struct _settings
+{
+    std::atomic<bool> enabled;
+    std::atomic<std::size_t> threshold;
+    std::atomic<std::size_t> nThread;
+
+    _settings()
+        : enabled(parallel_c::enabled),
+          threshold(parallel_c::threshold),
+          nThread(std::max<std::size_t>(std::thread::hardware_concurrency(), 1))
+    {}
+};
+
+inline _settings&
+_state()
+{
+    static _settings state;
+    return state;
+}
+
+/* Syntax: vtool::parallel::set_enabled(bool enable);
+ * Return: None. Turns parallel execution of element-wise work on or off.
+ */
+inline void
+set_enabled(const bool enable)
+{ _state().enabled = enable; }
+
+inline bool
+enabled()
+{ return _state().enabled; }
+
+/* Syntax: vtool::parallel::set_threshold(std::size_t N);
+ * Return: None. Vectors with fewer than N elements are processed serially.
+ */
+inline void
+set_threshold(const std::size_t N)
+{ _state().threshold = N; }
+
+inline std::size_t
+threshold()
+{ return _state().threshold; }
+
+/* Syntax: vtool::parallel::set_num_threads(std::size_t nThread);
+ * Return: None. 0 selects std::thread::hardware_concurrency().
+ */
+inline void
+set_num_threads(const std::size_t nThread)
+{
+    _state().nThread = nThread ? nThread
+                     : std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+inline std::size_t
+num_threads()
+{ return _state().nThread; }
+
+/* Syntax: vtool::parallel::pool();
+ * Return: std::shared_ptr to the library-wide thread pool, rebuilt when the
+ *         requested number of threads changed.
+ */
+inline std::shared_ptr<thread_pool>
+pool()
+{
+    static std::mutex mutex;
+    static std::shared_ptr<thread_pool> instance;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!instance || instance->size() != num_threads())
+        instance = std::make_shared<thread_pool>(num_threads());
+
+    return instance;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o ------------------ o
+    Parallel Execution
+  o ------------------ o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+/* Syntax: vtool::parallel::is_parallel(std::size_t N);
+ * Return: Boolean value indicating whether N elements are split over the pool.
+ */
+inline bool
+is_parallel(const std::size_t N)
+{
+    return enabled() && N >= threshold() && num_threads() > 1 && !_in_worker();
+}
+
+/* Syntax: vtool::parallel::for_each_range(std::size_t N, std::size_t elem_bytes, Fn fn);
+ * Return: None. Calls fn(begin, end) over cache-sized chunks of [0, N),
+ *         or fn(0, N) once when "N" is below the threshold.
+ */
+template <typename Fn>
+void
+for_each_range(const std::size_t N, const std::size_t elem_bytes, const Fn& fn)
+{
+    if (!is_parallel(N))
+    {
+        fn(std::size_t(0), N);
+        return;
+    }
+
+    const std::size_t chunk = std::max<std::size_t>(
+        parallel_c::chunk_bytes / std::max<std::size_t>(elem_bytes, 1), 1
+    );
+
+    pool()->run((N + chunk - 1) / chunk, [&](const std::size_t task){
+        const std::size_t begin = task * chunk;
+        fn(begin, std::min(begin + chunk, N));
+    });
+}
+
+/* Syntax: vtool::parallel::reduce_range(std::size_t N, std::size_t elem_bytes,
+ *                                       MapFn map, ReduceFn reduce);
+ * Return: map(begin, end) of fixed-size blocks of [0, N) folded with "reduce"
+ *         as a pairwise tree in block order, or map(0, N) when parallel
+ *         execution is off, "N" is below the threshold or "N" is zero. The blocks do not
+ *         depend on the number of threads, so neither does the result.
+ */
+template <typename R, typename MapFn, typename ReduceFn>
+R
+reduce_range(const std::size_t N, const std::size_t elem_bytes,
+             const MapFn& map, const ReduceFn& reduce)
+{
+    if (N == 0 || !enabled() || N < threshold())
+        return map(std::size_t(0), N);
+
+    const std::size_t chunk = std::max<std::size_t>(
+        parallel_c::chunk_bytes / std::max<std::size_t>(elem_bytes, 1), 1
+    );
+    const std::size_t nBlock = (N + chunk - 1) / chunk;
+
+    // not std::vector, whose packed bool elements cannot be written concurrently
+    const std::unique_ptr<R[]> partial(new R[nBlock]());
+    const std::function<void(std::size_t)> task = [&](const std::size_t block){
+        const std::size_t begin = block * chunk;
+        partial[block] = map(begin, std::min(begin + chunk, N));
+    };
+
+    if (num_threads() > 1)
+        pool()->run(nBlock, task);
+    else
+        for (std::size_t block = 0; block < nBlock; ++block) task(block);
+
+    for (std::size_t step = 1; step < nBlock; step *= 2)
+        for (std::size_t n = 0; n + step < nBlock; n += 2*step)
+            partial[n] = reduce(partial[n], partial[n + step]);
+
+    return partial[0];
+}
+
+    }   // namespace parallel
+}   // namespace vtool
+
+#endif  // __VTOOL_PARALLEL_H__
@@ -0,0 +1,1321 @@
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o ----------------------------------------- o
+    SIMD Kernels with Runtime CPU Dispatching
+  o ----------------------------------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VTOOL_SIMD_H__
+#define __VTOOL_SIMD_H__
+
+#include <cmath>
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+
+#include "vtool_traits.h"
+#include "vtool_parallel.h"
+
+#if !defined(NO_SIMD_KERNELS) \
+ && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#   define _VTOOL_SIMD_X86
+#endif
+
+#ifdef _VTOOL_SIMD_X86
+#   include <immintrin.h>
+#   ifdef _MSC_VER
+#       include <intrin.h>
+#   endif
+#endif
+
+// gcc and clang compile each kernel for its own target, msvc needs nothing
+#if defined(_VTOOL_SIMD_X86) && defined(__GNUC__)
+#   define _VTOOL_TARGET_SSE2   __attribute__((target("sse2")))
+#   define _VTOOL_TARGET_AVX2   __attribute__((target("avx2")))
+#   define _VTOOL_TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+#else
+#   define _VTOOL_TARGET_SSE2
+#   define _VTOOL_TARGET_AVX2
+#   define _VTOOL_TARGET_AVX512
+#endif
+
+// gcc would fuse a + b*n of fma targets and round differently than scalar code
+#if defined(_VTOOL_SIMD_X86) && defined(__GNUC__) && !defined(__clang__)
+#   define _VTOOL_NO_CONTRACT __attribute__((optimize("fp-contract=off")))
+#else
+#   define _VTOOL_NO_CONTRACT
+#endif
+
+namespace vtool {
+    namespace simd {
+
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o --------------------------- o
+    Instruction Set Dispatching
+  o --------------------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+// ---------------------------------- isa --------------------------------- //
+enum class isa: int
+{
+    scalar = 0,
+    sse2   = 1,
+    avx2   = 2,
+    avx512 = 3
+};
+
+inline const char*
+isa_name(const isa set)
+{
+    switch (set)
+    {
+        case isa::sse2:   return "sse2";
+        case isa::avx2:   return "avx2";
+        case isa::avx512: return "avx512";
+        default:          return "scalar";
+    }
+}
+
+inline isa
+_detect_isa()
+{
+#if defined(_VTOOL_SIMD_X86) && defined(__GNUC__)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+        return isa::avx512;
+    if (__builtin_cpu_supports("avx2"))
+        return isa::avx2;
+    if (__builtin_cpu_supports("sse2"))
+        return isa::sse2;
+#elif defined(_VTOOL_SIMD_X86) && defined(_MSC_VER)
+    int info[4];
+
+    __cpuid(info, 0);
+    const int max_leaf = info[0];
+
+    __cpuid(info, 1);
+    const bool sse2    = (info[3] & (1 << 26)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+
+    if (max_leaf >= 7 && (xcr0 & 0x6) == 0x6)
+    {
+        __cpuidex(info, 7, 0);
+        const bool avx2     = (info[1] & (1 << 5))  != 0;
+        const bool avx512f  = (info[1] & (1 << 16)) != 0;
+        const bool avx512bw = (info[1] & (1 << 30)) != 0;
+
+        if (avx512f && avx512bw && (xcr0 & 0xE6) == 0xE6)
+            return isa::avx512;
+        if (avx2)
+            return isa::avx2;
+    }
+    if (sse2)
+        return isa::sse2;
+#endif
+    return isa::scalar;
+}
+
+/* Syntax: vtool::simd::detected_isa();
+ * Return: Widest instruction set supported by the running CPU.
+ */
+inline isa
+detected_isa()
+{
+    static const isa detected = _detect_isa();
+    return detected;
+}
+
+inline std::atomic<int>&
+_active_isa()
+{
+    static std::atomic<int> active(static_cast<int>(detected_isa()));
+    return active;
+}
+
+/* Syntax: vtool::simd::active_isa();
+ * Return: Instruction set currently used by the dispatched kernels.
+ */
+inline isa
+active_isa()
+{
+    return static_cast<isa>(_active_isa().load(std::memory_order_relaxed));
+}
+
+/* Syntax: vtool::simd::set_isa(vtool::simd::isa set);
+ * Return: Instruction set actually selected. Requests above the detected
+ *         instruction set are clamped, isa::scalar forces the reference loops.
+ */
+inline isa
+set_isa(const isa set)
+{
+    const isa selected = static_cast<int>(set) > static_cast<int>(detected_isa())
+                       ? detected_isa() : set;
+
+    _active_isa().store(static_cast<int>(selected), std::memory_order_relaxed);
+    return selected;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o -------------- o
+    Scalar Kernels
+  o -------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+void _scalar_add(T* dst, const T* src, const std::size_t N)
+{ for (std::size_t n = 0; n < N; ++n) dst[n] += src[n]; }
+
+template <typename T>
+void _scalar_sub(T* dst, const T* src, const std::size_t N)
+{ for (std::size_t n = 0; n < N; ++n) dst[n] -= src[n]; }
+
+template <typename T>
+void _scalar_mul(T* dst, const T* src, const std::size_t N)
+{ for (std::size_t n = 0; n < N; ++n) dst[n] *= src[n]; }
+
+template <typename T>
+void _scalar_div(T* dst, const T* src, const std::size_t N)
+{ for (std::size_t n = 0; n < N; ++n) dst[n] /= src[n]; }
+
+// fused kernels: y = a*x + y, y = a*x + b*y, c = a*b + c, y = a*y + x, x.y,
+// and the ramp y[n] = a + b*n over [begin, end)
+template <typename T>
+void _scalar_axpy(const T a, const T* x, T* y, const std::size_t N)
+{ for (std::size_t n = 0; n < N; ++n) y[n] = a*x[n] + y[n]; }
+
+template <typename T>
+void _scalar_axpby(const T a, const T* x, const T b, T* y, const std::size_t N)
+{ for (std::size_t n = 0; n < N; ++n) y[n] = a*x[n] + b*y[n]; }
+
+template <typename T>
+void _scalar_fma(const T* a, const T* b, T* c, const std::size_t N)
+{ for (std::size_t n = 0; n < N; ++n) c[n] = a[n]*b[n] + c[n]; }
+
+template <typename T>
+void _scalar_scale_add(T* y, const T a, const T* x, const std::size_t N)
+{ for (std::size_t n = 0; n < N; ++n) y[n] = a*y[n] + x[n]; }
+
+// float products are exact in double, so every dot accumulates in double
+template <typename T>
+double _scalar_dot(const T* x, const T* y, const std::size_t N)
+{
+    double DOT = 0;
+    for (std::size_t n = 0; n < N; ++n) DOT += static_cast<double>(x[n])*y[n];
+    return DOT;
+}
+
+template <typename T>
+void _scalar_ramp(const T a, const T b, T* y, const std::size_t begin, const std::size_t end)
+{ for (std::size_t n = begin; n < end; ++n) y[n] = a + b*static_cast<T>(n); }
+
+// channel kernels over frames [begin, end): split dst[c][f] = src[f*C + c],
+// merge dst[f*C + c] = src[c][f]
+template <std::size_t C, typename T>
+void _scalar_split(const T* src, T* const* dst, const std::size_t begin, const std::size_t end)
+{
+    for (std::size_t f = begin; f < end; ++f)
+        for (std::size_t c = 0; c < C; ++c) dst[c][f] = src[f*C + c];
+}
+
+template <std::size_t C, typename T>
+void _scalar_merge(const T* const* src, T* dst, const std::size_t begin, const std::size_t end)
+{
+    for (std::size_t f = begin; f < end; ++f)
+        for (std::size_t c = 0; c < C; ++c) dst[f*C + c] = src[c][f];
+}
+
+// conversion kernels: dst = src*scale, float to integer rounds to nearest
+// and saturates, NaN goes to the lowest value
+inline void
+_scalar_i16_f32(const std::int16_t* src, float* dst, const float scale, const std::size_t N)
+{ for (std::size_t n = 0; n < N; ++n) dst[n] = static_cast<float>(src[n]) * scale; }
+
+inline void
+_scalar_i32_f32(const std::int32_t* src, float* dst, const float scale, const std::size_t N)
+{ for (std::size_t n = 0; n < N; ++n) dst[n] = static_cast<float>(src[n]) * scale; }
+
+inline void
+_scalar_f32_i16(const float* src, std::int16_t* dst, const float scale, const std::size_t N)
+{
+    for (std::size_t n = 0; n < N; ++n)
+    {
+        const float value = src[n] * scale;
+        dst[n] = !(value > -32768.0f) ? std::int16_t(-32768)
+               : value >= 32767.0f    ? std::int16_t(32767)
+               : static_cast<std::int16_t>(std::nearbyint(value));
+    }
+}
+
+inline void
+_scalar_f32_i32(const float* src, std::int32_t* dst, const float scale, const std::size_t N)
+{
+    for (std::size_t n = 0; n < N; ++n)
+    {
+        const float value = src[n] * scale;
+        dst[n] = !(value > -2147483648.0f) ? std::int32_t(-2147483647 - 1)
+               : value >= 2147483648.0f    ? std::int32_t(2147483647)
+               : static_cast<std::int32_t>(std::nearbyint(value));
+    }
+}
+
+// scan kernels: dst[n] = op(dst[n-1], src[n]), "src" may be "dst"
+template <typename T>
+void _scalar_scan_add(const T* src, T* dst, const std::size_t N)
+{ for (std::size_t n = 0; n < N; ++n) dst[n] = n ? dst[n-1] + src[n] : src[n]; }
+
+template <typename T>
+void _scalar_scan_max(const T* src, T* dst, const std::size_t N)
+{ for (std::size_t n = 0; n < N; ++n) dst[n] = n && !(src[n] > dst[n-1]) ? dst[n-1] : src[n]; }
+
+template <typename T>
+void _scalar_scan_min(const T* src, T* dst, const std::size_t N)
+{ for (std::size_t n = 0; n < N; ++n) dst[n] = n && !(src[n] < dst[n-1]) ? dst[n-1] : src[n]; }
+
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o ----------- o
+    x86 Kernels
+  o ----------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+#ifdef _VTOOL_SIMD_X86
+
+#define _VTOOL_REGISTER_TRAITS(_name, _target, T, _reg, _width, _set1,      \
+                               _load, _store, _add, _sub, _mul, _div)       \
+struct _name                                                                \
+{                                                                           \
+    using value_type = T;                                                   \
+    using register_type = _reg;                                             \
+    static constexpr std::size_t width = _width;                            \
+                                                                            \
+    _target static inline _reg set1(T a) { return _set1(a); }               \
+    _target static inline _reg load(const T* p) { return _load(p); }        \
+    _target static inline void store(T* p, _reg v) { _store(p, v); }        \
+    _target static inline _reg add(_reg a, _reg b) { return _add(a, b); }   \
+    _target static inline _reg sub(_reg a, _reg b) { return _sub(a, b); }   \
+    _target static inline _reg mul(_reg a, _reg b) { return _mul(a, b); }   \
+    _target static inline _reg div(_reg a, _reg b) { return _div(a, b); }   \
+};
+
+#define _VTOOL_SIMD_LOOP(_name, _target, _vop, _sop)                        \
+template <typename R>                                                       \
+_target void                                                                \
+_name(typename R::value_type* dst,                                          \
+      const typename R::value_type* src, const std::size_t N)               \
+{                                                                           \
+    std::size_t n = 0;                                                      \
+                                                                            \
+    for (; n + R::width <= N; n += R::width)                                \
+        R::store(dst + n, R::_vop(R::load(dst + n), R::load(src + n)));     \
+    for (; n < N; ++n)                                                      \
+        dst[n] _sop src[n];                                                 \
+}
+
+#define _VTOOL_BLAS_LOOPS(_isa, _target)                                    \
+template <typename R, typename T = typename R::value_type>                  \
+_target void                                                                \
+_isa##_axpy(const T a, const T* x, T* y, const std::size_t N)               \
+{                                                                           \
+    const typename R::register_type va = R::set1(a);                        \
+    std::size_t n = 0;                                                      \
+                                                                            \
+    for (; n + R::width <= N; n += R::width)                                \
+        R::store(y + n, R::add(R::mul(va, R::load(x + n)), R::load(y + n)));\
+    for (; n < N; ++n)                                                      \
+        y[n] = a*x[n] + y[n];                                               \
+}                                                                           \
+                                                                            \
+template <typename R, typename T = typename R::value_type>                  \
+_target void                                                                \
+_isa##_axpby(const T a, const T* x, const T b, T* y, const std::size_t N)   \
+{                                                                           \
+    const typename R::register_type va = R::set1(a);                        \
+    const typename R::register_type vb = R::set1(b);                        \
+    std::size_t n = 0;                                                      \
+                                                                            \
+    for (; n + R::width <= N; n += R::width)                                \
+        R::store(y + n, R::add(R::mul(va, R::load(x + n)),                  \
+                               R::mul(vb, R::load(y + n))));                \
+    for (; n < N; ++n)                                                      \
+        y[n] = a*x[n] + b*y[n];                                             \
+}                                                                           \
+                                                                            \
+template <typename R, typename T = typename R::value_type>                  \
+_target void                                                                \
+_isa##_fma(const T* a, const T* b, T* c, const std::size_t N)               \
+{                                                                           \
+    std::size_t n = 0;                                                      \
+                                                                            \
+    for (; n + R::width <= N; n += R::width)                                \
+        R::store(c + n, R::add(R::mul(R::load(a + n), R::load(b + n)),      \
+                               R::load(c + n)));                            \
+    for (; n < N; ++n)                                                      \
+        c[n] = a[n]*b[n] + c[n];                                            \
+}                                                                           \
+                                                                            \
+template <typename R, typename T = typename R::value_type>                  \
+_target void                                                                \
+_isa##_scale_add(T* y, const T a, const T* x, const std::size_t N)          \
+{                                                                           \
+    const typename R::register_type va = R::set1(a);                        \
+    std::size_t n = 0;                                                      \
+                                                                            \
+    for (; n + R::width <= N; n += R::width)                                \
+        R::store(y + n, R::add(R::mul(va, R::load(y + n)), R::load(x + n)));\
+    for (; n < N; ++n)                                                      \
+        y[n] = a*y[n] + x[n];                                               \
+}                                                                           \
+                                                                            \
+template <typename R, typename T = typename R::value_type>                  \
+_target T                                                                   \
+_isa##_dot(const T* x, const T* y, const std::size_t N)                     \
+{                                                                           \
+    typename R::register_type acc = R::set1(T(0));                          \
+    std::size_t n = 0;                                                      \
+                                                                            \
+    for (; n + R::width <= N; n += R::width)                                \
+        acc = R::add(acc, R::mul(R::load(x + n), R::load(y + n)));          \
+                                                                            \
+    T lanes[R::width];                                                      \
+    T DOT = 0;                                                              \
+                                                                            \
+    R::store(lanes, acc);                                                   \
+    for (std::size_t k = 0; k < R::width; ++k)                              \
+        DOT += lanes[k];                                                    \
+    for (; n < N; ++n)                                                      \
+        DOT += x[n]*y[n];                                                   \
+    return DOT;                                                             \
+}                                                                           \
+                                                                            \
+template <typename R, typename T = typename R::value_type>                  \
+_target _VTOOL_NO_CONTRACT void                                             \
+_isa##_ramp(const T a, const T b, T* y,                                     \
+            const std::size_t begin, const std::size_t end)                 \
+{                                                                           \
+    T lanes[R::width];                                                      \
+                                                                            \
+    for (std::size_t k = 0; k < R::width; ++k)                              \
+        lanes[k] = static_cast<T>(begin + k);                               \
+                                                                            \
+    const typename R::register_type va = R::set1(a);                        \
+    const typename R::register_type vb = R::set1(b);                        \
+    const typename R::register_type vw = R::set1(static_cast<T>(R::width)); \
+    typename R::register_type vn = R::load(lanes);                          \
+    std::size_t n = begin;                                                  \
+                                                                            \
+    for (; n + R::width <= end; n += R::width, vn = R::add(vn, vw))         \
+        R::store(y + n, R::add(va, R::mul(vb, vn)));                        \
+    for (; n < end; ++n)                                                    \
+        y[n] = a + b*static_cast<T>(n);                                     \
+}
+
+// integer registers go through void pointers and have no division
+#define _si128_load(p)     _mm_loadu_si128(reinterpret_cast<const __m128i*>(p))
+#define _si128_store(p, v) _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v)
+#define _si256_load(p)     _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))
+#define _si256_store(p, v) _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v)
+#define _si512_load(p)     _mm512_loadu_si512(static_cast<const void*>(p))
+#define _si512_store(p, v) _mm512_storeu_si512(static_cast<void*>(p), v)
+#define _no_simd_op(a, b)  ((void)(b), (a))
+
+// float dot in double lanes, "_widen" loads RD::width floats as doubles
+#define _VTOOL_WIDE_DOT(_isa, _target, RD, _widen)                          \
+_target inline double                                                       \
+_isa##_dot_f32(const float* x, const float* y, const std::size_t N)         \
+{                                                                           \
+    typename RD::register_type acc_lo = RD::set1(0.0);                      \
+    typename RD::register_type acc_hi = RD::set1(0.0);                      \
+    std::size_t n = 0;                                                      \
+                                                                            \
+    for (; n + 2*RD::width <= N; n += 2*RD::width)                          \
+    {                                                                       \
+        acc_lo = RD::add(acc_lo, RD::mul(_widen(x + n), _widen(y + n)));    \
+        acc_hi = RD::add(acc_hi, RD::mul(_widen(x + n + RD::width),         \
+                                         _widen(y + n + RD::width)));       \
+    }                                                                       \
+                                                                            \
+    double lanes[RD::width];                                                \
+    double DOT = 0;                                                         \
+                                                                            \
+    RD::store(lanes, RD::add(acc_lo, acc_hi));                              \
+    for (std::size_t k = 0; k < RD::width; ++k)                             \
+        DOT += lanes[k];                                                    \
+    for (; n < N; ++n)                                                      \
+        DOT += static_cast<double>(x[n])*y[n];                              \
+    return DOT;                                                             \
+}
+
+#define _sse2_widen(p)   _mm_cvtps_pd(_mm_loadl_pi(_mm_setzero_ps(),        \
+                                     reinterpret_cast<const __m64*>(p)))
+#define _avx2_widen(p)   _mm256_cvtps_pd(_mm_loadu_ps(p))
+// the masked avx512 conversion keeps gcc quiet about its undefined source
+#define _avx512_widen(p) _mm512_maskz_cvtps_pd(0xFF, _mm256_loadu_ps(p))
+
+// --------------------------------- sse2 --------------------------------- //
+_VTOOL_REGISTER_TRAITS(_sse2_f32, _VTOOL_TARGET_SSE2, float, __m128, 4, _mm_set1_ps,
+                       _mm_loadu_ps, _mm_storeu_ps,
+                       _mm_add_ps, _mm_sub_ps, _mm_mul_ps, _mm_div_ps)
+_VTOOL_REGISTER_TRAITS(_sse2_f64, _VTOOL_TARGET_SSE2, double, __m128d, 2, _mm_set1_pd,
+                       _mm_loadu_pd, _mm_storeu_pd,
+                       _mm_add_pd, _mm_sub_pd, _mm_mul_pd, _mm_div_pd)
+_VTOOL_REGISTER_TRAITS(_sse2_i16, _VTOOL_TARGET_SSE2, std::int16_t, __m128i, 8, _mm_set1_epi16,
+                       _si128_load, _si128_store,
+                       _mm_add_epi16, _mm_sub_epi16, _mm_mullo_epi16, _no_simd_op)
+_VTOOL_REGISTER_TRAITS(_sse2_i32, _VTOOL_TARGET_SSE2, std::int32_t, __m128i, 4, _mm_set1_epi32,
+                       _si128_load, _si128_store,
+                       _mm_add_epi32, _mm_sub_epi32, _no_simd_op, _no_simd_op)
+
+_VTOOL_SIMD_LOOP(_sse2_add, _VTOOL_TARGET_SSE2, add, +=)
+_VTOOL_SIMD_LOOP(_sse2_sub, _VTOOL_TARGET_SSE2, sub, -=)
+_VTOOL_SIMD_LOOP(_sse2_mul, _VTOOL_TARGET_SSE2, mul, *=)
+_VTOOL_SIMD_LOOP(_sse2_div, _VTOOL_TARGET_SSE2, div, /=)
+_VTOOL_BLAS_LOOPS(_sse2, _VTOOL_TARGET_SSE2)
+_VTOOL_WIDE_DOT(_sse2, _VTOOL_TARGET_SSE2, _sse2_f64, _sse2_widen)
+
+// --------------------------------- avx2 --------------------------------- //
+_VTOOL_REGISTER_TRAITS(_avx2_f32, _VTOOL_TARGET_AVX2, float, __m256, 8, _mm256_set1_ps,
+                       _mm256_loadu_ps, _mm256_storeu_ps,
+                       _mm256_add_ps, _mm256_sub_ps, _mm256_mul_ps, _mm256_div_ps)
+_VTOOL_REGISTER_TRAITS(_avx2_f64, _VTOOL_TARGET_AVX2, double, __m256d, 4, _mm256_set1_pd,
+                       _mm256_loadu_pd, _mm256_storeu_pd,
+                       _mm256_add_pd, _mm256_sub_pd, _mm256_mul_pd, _mm256_div_pd)
+_VTOOL_REGISTER_TRAITS(_avx2_i16, _VTOOL_TARGET_AVX2, std::int16_t, __m256i, 16, _mm256_set1_epi16,
+                       _si256_load, _si256_store,
+                       _mm256_add_epi16, _mm256_sub_epi16, _mm256_mullo_epi16, _no_simd_op)
+_VTOOL_REGISTER_TRAITS(_avx2_i32, _VTOOL_TARGET_AVX2, std::int32_t, __m256i, 8, _mm256_set1_epi32,
+                       _si256_load, _si256_store,
+                       _mm256_add_epi32, _mm256_sub_epi32, _mm256_mullo_epi32, _no_simd_op)
+
+_VTOOL_SIMD_LOOP(_avx2_add, _VTOOL_TARGET_AVX2, add, +=)
+_VTOOL_SIMD_LOOP(_avx2_sub, _VTOOL_TARGET_AVX2, sub, -=)
+_VTOOL_SIMD_LOOP(_avx2_mul, _VTOOL_TARGET_AVX2, mul, *=)
+_VTOOL_SIMD_LOOP(_avx2_div, _VTOOL_TARGET_AVX2, div, /=)
+_VTOOL_BLAS_LOOPS(_avx2, _VTOOL_TARGET_AVX2)
+_VTOOL_WIDE_DOT(_avx2, _VTOOL_TARGET_AVX2, _avx2_f64, _avx2_widen)
+
+// -------------------------------- avx512 -------------------------------- //
+_VTOOL_REGISTER_TRAITS(_avx512_f32, _VTOOL_TARGET_AVX512, float, __m512, 16, _mm512_set1_ps,
+                       _mm512_loadu_ps, _mm512_storeu_ps,
+                       _mm512_add_ps, _mm512_sub_ps, _mm512_mul_ps, _mm512_div_ps)
+_VTOOL_REGISTER_TRAITS(_avx512_f64, _VTOOL_TARGET_AVX512, double, __m512d, 8, _mm512_set1_pd,
+                       _mm512_loadu_pd, _mm512_storeu_pd,
+                       _mm512_add_pd, _mm512_sub_pd, _mm512_mul_pd, _mm512_div_pd)
+_VTOOL_REGISTER_TRAITS(_avx512_i16, _VTOOL_TARGET_AVX512, std::int16_t, __m512i, 32, _mm512_set1_epi16,
+                       _si512_load, _si512_store,
+                       _mm512_add_epi16, _mm512_sub_epi16, _mm512_mullo_epi16, _no_simd_op)
+_VTOOL_REGISTER_TRAITS(_avx512_i32, _VTOOL_TARGET_AVX512, std::int32_t, __m512i, 16, _mm512_set1_epi32,
+                       _si512_load, _si512_store,
+                       _mm512_add_epi32, _mm512_sub_epi32, _mm512_mullo_epi32, _no_simd_op)
+
+_VTOOL_SIMD_LOOP(_avx512_add, _VTOOL_TARGET_AVX512, add, +=)
+_VTOOL_SIMD_LOOP(_avx512_sub, _VTOOL_TARGET_AVX512, sub, -=)
+_VTOOL_SIMD_LOOP(_avx512_mul, _VTOOL_TARGET_AVX512, mul, *=)
+_VTOOL_SIMD_LOOP(_avx512_div, _VTOOL_TARGET_AVX512, div, /=)
+_VTOOL_BLAS_LOOPS(_avx512, _VTOOL_TARGET_AVX512)
+_VTOOL_WIDE_DOT(_avx512, _VTOOL_TARGET_AVX512, _avx512_f64, _avx512_widen)
+
+// ----------------------------- sse2 channels ---------------------------- //
+// shuffles only move bits, so every 4-byte type runs as float
+// and every 8-byte type as double
+template <typename T>
+_VTOOL_TARGET_SSE2 void
+_sse2_split2_32(const T* src, T* const* dst, const std::size_t begin, const std::size_t end)
+{
+    const float* s = reinterpret_cast<const float*>(src);
+    float* d0 = reinterpret_cast<float*>(dst[0]);
+    float* d1 = reinterpret_cast<float*>(dst[1]);
+    std::size_t f = begin;
+
+    for (; f + 4 <= end; f += 4)
+    {
+        const __m128 a = _mm_loadu_ps(s + 2*f);
+        const __m128 b = _mm_loadu_ps(s + 2*f + 4);
+        _mm_storeu_ps(d0 + f, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(d1 + f, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+    _scalar_split<2>(src, dst, f, end);
+}
+
+template <typename T>
+_VTOOL_TARGET_SSE2 void
+_sse2_merge2_32(const T* const* src, T* dst, const std::size_t begin, const std::size_t end)
+{
+    const float* s0 = reinterpret_cast<const float*>(src[0]);
+    const float* s1 = reinterpret_cast<const float*>(src[1]);
+    float* d = reinterpret_cast<float*>(dst);
+    std::size_t f = begin;
+
+    for (; f + 4 <= end; f += 4)
+    {
+        const __m128 a = _mm_loadu_ps(s0 + f);
+        const __m128 b = _mm_loadu_ps(s1 + f);
+        _mm_storeu_ps(d + 2*f,     _mm_unpacklo_ps(a, b));
+        _mm_storeu_ps(d + 2*f + 4, _mm_unpackhi_ps(a, b));
+    }
+    _scalar_merge<2>(src, dst, f, end);
+}
+
+template <typename T>
+_VTOOL_TARGET_SSE2 void
+_sse2_split4_32(const T* src, T* const* dst, const std::size_t begin, const std::size_t end)
+{
+    const float* s = reinterpret_cast<const float*>(src);
+    std::size_t f = begin;
+
+    for (; f + 4 <= end; f += 4)
+    {
+        __m128 r0 = _mm_loadu_ps(s + 4*f);
+        __m128 r1 = _mm_loadu_ps(s + 4*f + 4);
+        __m128 r2 = _mm_loadu_ps(s + 4*f + 8);
+        __m128 r3 = _mm_loadu_ps(s + 4*f + 12);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(reinterpret_cast<float*>(dst[0]) + f, r0);
+        _mm_storeu_ps(reinterpret_cast<float*>(dst[1]) + f, r1);
+        _mm_storeu_ps(reinterpret_cast<float*>(dst[2]) + f, r2);
+        _mm_storeu_ps(reinterpret_cast<float*>(dst[3]) + f, r3);
+    }
+    _scalar_split<4>(src, dst, f, end);
+}
+
+template <typename T>
+_VTOOL_TARGET_SSE2 void
+_sse2_merge4_32(const T* const* src, T* dst, const std::size_t begin, const std::size_t end)
+{
+    float* d = reinterpret_cast<float*>(dst);
+    std::size_t f = begin;
+
+    for (; f + 4 <= end; f += 4)
+    {
+        __m128 r0 = _mm_loadu_ps(reinterpret_cast<const float*>(src[0]) + f);
+        __m128 r1 = _mm_loadu_ps(reinterpret_cast<const float*>(src[1]) + f);
+        __m128 r2 = _mm_loadu_ps(reinterpret_cast<const float*>(src[2]) + f);
+        __m128 r3 = _mm_loadu_ps(reinterpret_cast<const float*>(src[3]) + f);
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(d + 4*f,      r0);
+        _mm_storeu_ps(d + 4*f + 4,  r1);
+        _mm_storeu_ps(d + 4*f + 8,  r2);
+        _mm_storeu_ps(d + 4*f + 12, r3);
+    }
+    _scalar_merge<4>(src, dst, f, end);
+}
+
+template <typename T>
+_VTOOL_TARGET_SSE2 void
+_sse2_split2_64(const T* src, T* const* dst, const std::size_t begin, const std::size_t end)
+{
+    const double* s = reinterpret_cast<const double*>(src);
+    double* d0 = reinterpret_cast<double*>(dst[0]);
+    double* d1 = reinterpret_cast<double*>(dst[1]);
+    std::size_t f = begin;
+
+    for (; f + 2 <= end; f += 2)
+    {
+        const __m128d a = _mm_loadu_pd(s + 2*f);
+        const __m128d b = _mm_loadu_pd(s + 2*f + 2);
+        _mm_storeu_pd(d0 + f, _mm_unpacklo_pd(a, b));
+        _mm_storeu_pd(d1 + f, _mm_unpackhi_pd(a, b));
+    }
+    _scalar_split<2>(src, dst, f, end);
+}
+
+template <typename T>
+_VTOOL_TARGET_SSE2 void
+_sse2_merge2_64(const T* const* src, T* dst, const std::size_t begin, const std::size_t end)
+{
+    const double* s0 = reinterpret_cast<const double*>(src[0]);
+    const double* s1 = reinterpret_cast<const double*>(src[1]);
+    double* d = reinterpret_cast<double*>(dst);
+    std::size_t f = begin;
+
+    for (; f + 2 <= end; f += 2)
+    {
+        const __m128d a = _mm_loadu_pd(s0 + f);
+        const __m128d b = _mm_loadu_pd(s1 + f);
+        _mm_storeu_pd(d + 2*f,     _mm_unpacklo_pd(a, b));
+        _mm_storeu_pd(d + 2*f + 2, _mm_unpackhi_pd(a, b));
+    }
+    _scalar_merge<2>(src, dst, f, end);
+}
+
+// --------------------------- sse2 conversions --------------------------- //
+_VTOOL_TARGET_SSE2 inline void
+_sse2_i16_f32(const std::int16_t* src, float* dst, const float scale, const std::size_t N)
+{
+    const __m128 vs = _mm_set1_ps(scale);
+    std::size_t n = 0;
+
+    for (; n + 8 <= N; n += 8)
+    {
+        const __m128i v = _si128_load(src + n);
+        const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+
+        _mm_storeu_ps(dst + n,     _mm_mul_ps(_mm_cvtepi32_ps(lo), vs));
+        _mm_storeu_ps(dst + n + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), vs));
+    }
+    _scalar_i16_f32(src + n, dst + n, scale, N - n);
+}
+
+_VTOOL_TARGET_SSE2 inline void
+_sse2_i32_f32(const std::int32_t* src, float* dst, const float scale, const std::size_t N)
+{
+    const __m128 vs = _mm_set1_ps(scale);
+    std::size_t n = 0;
+
+    for (; n + 4 <= N; n += 4)
+        _mm_storeu_ps(dst + n, _mm_mul_ps(_mm_cvtepi32_ps(_si128_load(src + n)), vs));
+    _scalar_i32_f32(src + n, dst + n, scale, N - n);
+}
+
+// max/min return their second operand for NaN, which clamps it to -32768
+_VTOOL_TARGET_SSE2 inline void
+_sse2_f32_i16(const float* src, std::int16_t* dst, const float scale, const std::size_t N)
+{
+    const __m128 vs = _mm_set1_ps(scale);
+    const __m128 lo = _mm_set1_ps(-32768.0f);
+    const __m128 hi = _mm_set1_ps(32767.0f);
+    std::size_t n = 0;
+
+    for (; n + 8 <= N; n += 8)
+    {
+        const __m128 a = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + n), vs), lo), hi);
+        const __m128 b = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + n + 4), vs), lo), hi);
+
+        _si128_store(dst + n, _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b)));
+    }
+    _scalar_f32_i16(src + n, dst + n, scale, N - n);
+}
+
+// out of range and NaN convert to 0x80000000, flipped to INT32_MAX above 2^31
+_VTOOL_TARGET_SSE2 inline void
+_sse2_f32_i32(const float* src, std::int32_t* dst, const float scale, const std::size_t N)
+{
+    const __m128 vs = _mm_set1_ps(scale);
+    const __m128 hi = _mm_set1_ps(2147483648.0f);
+    std::size_t n = 0;
+
+    for (; n + 4 <= N; n += 4)
+    {
+        const __m128 v = _mm_mul_ps(_mm_loadu_ps(src + n), vs);
+        const __m128i overflow = _mm_castps_si128(_mm_cmpge_ps(v, hi));
+
+        _si128_store(dst + n, _mm_xor_si128(_mm_cvtps_epi32(v), overflow));
+    }
+    _scalar_f32_i32(src + n, dst + n, scale, N - n);
+}
+
+// ------------------------------ sse2 scans ------------------------------ //
+/*
+ * In-register scans: log2(width) shifted ops, then the last lane of the
+ * previous register is broadcast and combined. Sums shift in zeros, max and
+ * min repeat lane 0 instead, which they are indifferent to.
+ */
+#define _ps_shift1_add(x) _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 4))
+#define _ps_shift2_add(x) _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 8))
+#define _ps_shift1_max(x) _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 1, 0, 0))
+#define _ps_shift2_max(x) _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 0, 1, 0))
+#define _ps_shift1_min    _ps_shift1_max
+#define _ps_shift2_min    _ps_shift2_max
+#define _pd_shift1_add(x) _mm_castsi128_pd(_mm_slli_si128(_mm_castpd_si128(x), 8))
+#define _pd_shift1_max(x) _mm_unpacklo_pd(x, x)
+#define _pd_shift1_min    _pd_shift1_max
+#define _scan_add(a, x)   ((a) + (x))
+#define _scan_max(a, x)   (!((x) > (a)) ? (a) : (x))
+#define _scan_min(a, x)   (!((x) < (a)) ? (a) : (x))
+
+#define _VTOOL_SSE2_SCAN(_op)                                               \
+_VTOOL_TARGET_SSE2 inline void                                              \
+_sse2_scan_##_op##_f32(const float* src, float* dst, const std::size_t N)   \
+{                                                                           \
+    std::size_t n = 0;                                                      \
+                                                                            \
+    if (N >= 4)                                                             \
+    {                                                                       \
+        __m128 x = _mm_loadu_ps(src);                                       \
+        x = _mm_##_op##_ps(x, _ps_shift1_##_op(x));                         \
+        x = _mm_##_op##_ps(x, _ps_shift2_##_op(x));                         \
+        _mm_storeu_ps(dst, x);                                              \
+                                                                            \
+        for (n = 4; n + 4 <= N; n += 4)                                     \
+        {                                                                   \
+            const __m128 carry = _mm_shuffle_ps(x, x, 0xFF);                \
+            x = _mm_loadu_ps(src + n);                                      \
+            x = _mm_##_op##_ps(x, _ps_shift1_##_op(x));                     \
+            x = _mm_##_op##_ps(x, _ps_shift2_##_op(x));                     \
+            x = _mm_##_op##_ps(x, carry);                                   \
+            _mm_storeu_ps(dst + n, x);                                      \
+        }                                                                   \
+    }                                                                       \
+    for (; n < N; ++n)                                                      \
+        dst[n] = n ? _scan_##_op(dst[n-1], src[n]) : src[n];                \
+}                                                                           \
+                                                                            \
+_VTOOL_TARGET_SSE2 inline void                                              \
+_sse2_scan_##_op##_f64(const double* src, double* dst, const std::size_t N) \
+{                                                                           \
+    std::size_t n = 0;                                                      \
+                                                                            \
+    if (N >= 2)                                                             \
+    {                                                                       \
+        __m128d x = _mm_loadu_pd(src);                                      \
+        x = _mm_##_op##_pd(x, _pd_shift1_##_op(x));                         \
+        _mm_storeu_pd(dst, x);                                              \
+                                                                            \
+        for (n = 2; n + 2 <= N; n += 2)                                     \
+        {                                                                   \
+            const __m128d carry = _mm_unpackhi_pd(x, x);                    \
+            x = _mm_loadu_pd(src + n);                                      \
+            x = _mm_##_op##_pd(x, _pd_shift1_##_op(x));                     \
+            x = _mm_##_op##_pd(x, carry);                                   \
+            _mm_storeu_pd(dst + n, x);                                      \
+        }                                                                   \
+    }                                                                       \
+    for (; n < N; ++n)                                                      \
+        dst[n] = n ? _scan_##_op(dst[n-1], src[n]) : src[n];                \
+}
+
+_VTOOL_SSE2_SCAN(add)
+_VTOOL_SSE2_SCAN(max)
+_VTOOL_SSE2_SCAN(min)
+
+#undef _ps_shift1_add
+#undef _ps_shift2_add
+#undef _ps_shift1_max
+#undef _ps_shift2_max
+#undef _ps_shift1_min
+#undef _ps_shift2_min
+#undef _pd_shift1_add
+#undef _pd_shift1_max
+#undef _pd_shift1_min
+#undef _scan_add
+#undef _scan_max
+#undef _scan_min
+#undef _VTOOL_SSE2_SCAN
+
+#undef _si128_load
+#undef _si128_store
+#undef _si256_load
+#undef _si256_store
+#undef _si512_load
+#undef _si512_store
+#undef _no_simd_op
+#undef _sse2_widen
+#undef _avx2_widen
+#undef _avx512_widen
+
+#undef _VTOOL_REGISTER_TRAITS
+#undef _VTOOL_SIMD_LOOP
+#undef _VTOOL_BLAS_LOOPS
+#undef _VTOOL_WIDE_DOT
+
+#endif  // _VTOOL_SIMD_X86
+
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o ------------- o
+    Kernel Tables
+  o ------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------- is_kernel<T> ----------------------------- //
+template <typename T>
+struct _is_kernel: std::integral_constant<bool,
+    std::is_same<T, float>::value        || std::is_same<T, double>::value
+ || std::is_same<T, std::int16_t>::value || std::is_same<T, std::int32_t>::value
+> {};
+
+template <typename T>
+struct is_kernel: std::enable_if<_is_kernel<T>::value, bool> {};
+
+// --------------------------- _kernel_table<T> --------------------------- //
+template <typename T>
+struct _kernel_table
+{
+    void (*add)(T*, const T*, std::size_t);
+    void (*sub)(T*, const T*, std::size_t);
+    void (*mul)(T*, const T*, std::size_t);
+    void (*div)(T*, const T*, std::size_t);
+};
+
+#define _VTOOL_SCALAR_TABLE(T) \
+    { _scalar_add<T>, _scalar_sub<T>, _scalar_mul<T>, _scalar_div<T> }
+
+template <typename T>
+inline const _kernel_table<T>&
+_kernels(const isa);
+
+#ifdef _VTOOL_SIMD_X86
+template <>
+inline const _kernel_table<float>&
+_kernels<float>(const isa set)
+{
+    static const _kernel_table<float> table[] = {
+        _VTOOL_SCALAR_TABLE(float),
+        { _sse2_add<_sse2_f32>, _sse2_sub<_sse2_f32>,
+          _sse2_mul<_sse2_f32>, _sse2_div<_sse2_f32> },
+        { _avx2_add<_avx2_f32>, _avx2_sub<_avx2_f32>,
+          _avx2_mul<_avx2_f32>, _avx2_div<_avx2_f32> },
+        { _avx512_add<_avx512_f32>, _avx512_sub<_avx512_f32>,
+          _avx512_mul<_avx512_f32>, _avx512_div<_avx512_f32> }
+    };
+    return table[static_cast<int>(set)];
+}
+
+template <>
+inline const _kernel_table<double>&
+_kernels<double>(const isa set)
+{
+    static const _kernel_table<double> table[] = {
+        _VTOOL_SCALAR_TABLE(double),
+        { _sse2_add<_sse2_f64>, _sse2_sub<_sse2_f64>,
+          _sse2_mul<_sse2_f64>, _sse2_div<_sse2_f64> },
+        { _avx2_add<_avx2_f64>, _avx2_sub<_avx2_f64>,
+          _avx2_mul<_avx2_f64>, _avx2_div<_avx2_f64> },
+        { _avx512_add<_avx512_f64>, _avx512_sub<_avx512_f64>,
+          _avx512_mul<_avx512_f64>, _avx512_div<_avx512_f64> }
+    };
+    return table[static_cast<int>(set)];
+}
+
+// integer division has no simd instruction
+template <>
+inline const _kernel_table<std::int16_t>&
+_kernels<std::int16_t>(const isa set)
+{
+    static const _kernel_table<std::int16_t> table[] = {
+        _VTOOL_SCALAR_TABLE(std::int16_t),
+        { _sse2_add<_sse2_i16>, _sse2_sub<_sse2_i16>,
+          _sse2_mul<_sse2_i16>, _scalar_div<std::int16_t> },
+        { _avx2_add<_avx2_i16>, _avx2_sub<_avx2_i16>,
+          _avx2_mul<_avx2_i16>, _scalar_div<std::int16_t> },
+        { _avx512_add<_avx512_i16>, _avx512_sub<_avx512_i16>,
+          _avx512_mul<_avx512_i16>, _scalar_div<std::int16_t> }
+    };
+    return table[static_cast<int>(set)];
+}
+
+// sse2 has no 32-bit low multiplication either
+template <>
+inline const _kernel_table<std::int32_t>&
+_kernels<std::int32_t>(const isa set)
+{
+    static const _kernel_table<std::int32_t> table[] = {
+        _VTOOL_SCALAR_TABLE(std::int32_t),
+        { _sse2_add<_sse2_i32>, _sse2_sub<_sse2_i32>,
+          _scalar_mul<std::int32_t>, _scalar_div<std::int32_t> },
+        { _avx2_add<_avx2_i32>, _avx2_sub<_avx2_i32>,
+          _avx2_mul<_avx2_i32>, _scalar_div<std::int32_t> },
+        { _avx512_add<_avx512_i32>, _avx512_sub<_avx512_i32>,
+          _avx512_mul<_avx512_i32>, _scalar_div<std::int32_t> }
+    };
+    return table[static_cast<int>(set)];
+}
+#else
+template <typename T>
+inline const _kernel_table<T>&
+_kernels(const isa)
+{
+    static const _kernel_table<T> table = _VTOOL_SCALAR_TABLE(T);
+    return table;
+}
+#endif  // _VTOOL_SIMD_X86
+
+#undef _VTOOL_SCALAR_TABLE
+
+template <typename T>
+inline const _kernel_table<T>&
+_active_kernels()
+{
+    return _kernels<T>(active_isa());
+}
+
+// -------------------------- is_blas_kernel<T> --------------------------- //
+template <typename T>
+struct _is_blas_kernel: std::integral_constant<bool,
+    std::is_same<T, float>::value || std::is_same<T, double>::value
+> {};
+
+template <typename T>
+struct is_blas_kernel: std::enable_if<_is_blas_kernel<T>::value, bool> {};
+
+// ---------------------------- _blas_table<T> ---------------------------- //
+template <typename T>
+struct _blas_table
+{
+    void   (*axpy)(T, const T*, T*, std::size_t);
+    void   (*axpby)(T, const T*, T, T*, std::size_t);
+    void   (*fma)(const T*, const T*, T*, std::size_t);
+    void   (*scale_add)(T*, T, const T*, std::size_t);
+    double (*dot)(const T*, const T*, std::size_t);
+    void   (*ramp)(T, T, T*, std::size_t, std::size_t);
+};
+
+#define _VTOOL_BLAS_TABLE(_isa, R, _dot)                                    \
+    { _isa##_axpy<R>, _isa##_axpby<R>, _isa##_fma<R>,                       \
+      _isa##_scale_add<R>, _dot, _isa##_ramp<R> }
+
+#define _VTOOL_SCALAR_BLAS_TABLE(T)                                         \
+    { _scalar_axpy<T>, _scalar_axpby<T>, _scalar_fma<T>,                    \
+      _scalar_scale_add<T>, _scalar_dot<T>, _scalar_ramp<T> }
+
+template <typename T>
+inline const _blas_table<T>&
+_blas_kernels(const isa);
+
+#ifdef _VTOOL_SIMD_X86
+template <>
+inline const _blas_table<float>&
+_blas_kernels<float>(const isa set)
+{
+    static const _blas_table<float> table[] = {
+        _VTOOL_SCALAR_BLAS_TABLE(float),
+        _VTOOL_BLAS_TABLE(_sse2, _sse2_f32, _sse2_dot_f32),
+        _VTOOL_BLAS_TABLE(_avx2, _avx2_f32, _avx2_dot_f32),
+        _VTOOL_BLAS_TABLE(_avx512, _avx512_f32, _avx512_dot_f32)
+    };
+    return table[static_cast<int>(set)];
+}
+
+template <>
+inline const _blas_table<double>&
+_blas_kernels<double>(const isa set)
+{
+    static const _blas_table<double> table[] = {
+        _VTOOL_SCALAR_BLAS_TABLE(double),
+        _VTOOL_BLAS_TABLE(_sse2, _sse2_f64, _sse2_dot<_sse2_f64>),
+        _VTOOL_BLAS_TABLE(_avx2, _avx2_f64, _avx2_dot<_avx2_f64>),
+        _VTOOL_BLAS_TABLE(_avx512, _avx512_f64, _avx512_dot<_avx512_f64>)
+    };
+    return table[static_cast<int>(set)];
+}
+#else
+template <typename T>
+inline const _blas_table<T>&
+_blas_kernels(const isa)
+{
+    static const _blas_table<T> table = _VTOOL_SCALAR_BLAS_TABLE(T);
+    return table;
+}
+#endif  // _VTOOL_SIMD_X86
+
+#undef _VTOOL_BLAS_TABLE
+#undef _VTOOL_SCALAR_BLAS_TABLE
+
+template <typename T>
+inline const _blas_table<T>&
+_active_blas_kernels()
+{
+    return _blas_kernels<T>(active_isa());
+}
+
+// ---------------------------- channel kernels --------------------------- //
+template <typename T>
+using _split_fn = void (*)(const T*, T* const*, std::size_t, std::size_t);
+
+template <typename T>
+using _merge_fn = void (*)(const T* const*, T*, std::size_t, std::size_t);
+
+/* Syntax: vtool::simd::_split_kernel<C, T>();
+ *         vtool::simd::_merge_kernel<C, T>();
+ * Return: Kernel moving "C" interleaved channels to separate buffers and
+ *         back. Every channel count unrolls at compile time, 2 channels of
+ *         4- and 8-byte and 4 channels of 4-byte elements also use shuffles.
+ */
+template <std::size_t C, typename T>
+inline _split_fn<T>
+_split_kernel()
+{
+#ifdef _VTOOL_SIMD_X86
+    if (active_isa() != isa::scalar && std::is_arithmetic<T>::value)
+    {
+        if (C == 2 && sizeof(T) == 4) return _sse2_split2_32<T>;
+        if (C == 4 && sizeof(T) == 4) return _sse2_split4_32<T>;
+        if (C == 2 && sizeof(T) == 8) return _sse2_split2_64<T>;
+    }
+#endif
+    return _scalar_split<C, T>;
+}
+
+template <std::size_t C, typename T>
+inline _merge_fn<T>
+_merge_kernel()
+{
+#ifdef _VTOOL_SIMD_X86
+    if (active_isa() != isa::scalar && std::is_arithmetic<T>::value)
+    {
+        if (C == 2 && sizeof(T) == 4) return _sse2_merge2_32<T>;
+        if (C == 4 && sizeof(T) == 4) return _sse2_merge4_32<T>;
+        if (C == 2 && sizeof(T) == 8) return _sse2_merge2_64<T>;
+    }
+#endif
+    return _scalar_merge<C, T>;
+}
+
+// -------------------------- conversion kernels -------------------------- //
+template <typename From, typename To>
+using _convert_fn = void (*)(const From*, To*, float, std::size_t);
+
+struct _convert_table
+{
+    _convert_fn<std::int16_t, float> i16_f32;
+    _convert_fn<std::int32_t, float> i32_f32;
+    _convert_fn<float, std::int16_t> f32_i16;
+    _convert_fn<float, std::int32_t> f32_i32;
+};
+
+/* Syntax: vtool::simd::_convert_kernels();
+ * Return: Table of the int16 and int32 PCM conversion kernels. Every
+ *         instruction set beyond scalar runs the sse2 ones.
+ */
+inline const _convert_table&
+_convert_kernels()
+{
+    static const _convert_table table[] = {
+        { _scalar_i16_f32, _scalar_i32_f32, _scalar_f32_i16, _scalar_f32_i32 },
+#ifdef _VTOOL_SIMD_X86
+        { _sse2_i16_f32, _sse2_i32_f32, _sse2_f32_i16, _sse2_f32_i32 }
+#endif
+    };
+#ifdef _VTOOL_SIMD_X86
+    return table[active_isa() != isa::scalar];
+#else
+    return table[0];
+#endif
+}
+
+// ----------------------------- scan kernels ----------------------------- //
+template <typename T>
+using _scan_fn = void (*)(const T*, T*, std::size_t);
+
+template <typename T>
+struct _scan_table
+{
+    _scan_fn<T> add;
+    _scan_fn<T> max;
+    _scan_fn<T> min;
+};
+
+/* Syntax: vtool::simd::_scan_kernels<T>();
+ * Return: Table of the inclusive scan kernels of float or double. Every
+ *         instruction set beyond scalar runs the sse2 ones.
+ */
+template <typename T>
+inline const _scan_table<T>&
+_scan_kernels();
+
+template <>
+inline const _scan_table<float>&
+_scan_kernels<float>()
+{
+    static const _scan_table<float> table[] = {
+        { _scalar_scan_add<float>, _scalar_scan_max<float>, _scalar_scan_min<float> },
+#ifdef _VTOOL_SIMD_X86
+        { _sse2_scan_add_f32, _sse2_scan_max_f32, _sse2_scan_min_f32 }
+#endif
+    };
+#ifdef _VTOOL_SIMD_X86
+    return table[active_isa() != isa::scalar];
+#else
+    return table[0];
+#endif
+}
+
+template <>
+inline const _scan_table<double>&
+_scan_kernels<double>()
+{
+    static const _scan_table<double> table[] = {
+        { _scalar_scan_add<double>, _scalar_scan_max<double>, _scalar_scan_min<double> },
+#ifdef _VTOOL_SIMD_X86
+        { _sse2_scan_add_f64, _sse2_scan_max_f64, _sse2_scan_min_f64 }
+#endif
+    };
+#ifdef _VTOOL_SIMD_X86
+    return table[active_isa() != isa::scalar];
+#else
+    return table[0];
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o ---------------- o
+    Compound Kernels
+  o ---------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+/*
+ * The generic overloads are the reference element-wise loops. Same-typed
+ * float, double, int16 and int32 vectors are routed to the dispatched kernel
+ * of the active instruction set instead. Mixed element types whose common
+ * type has a kernel (float += int16, double += float, int32 *= float, ...)
+ * are converted to it block by block on the stack and run through that
+ * kernel, which rounds exactly like lhs[n] = T1(C(lhs[n]) op C(rhs[n])).
+ */
+
+// elements converted per block by the mixed compound kernels
+static const std::size_t
+_convert_block = 256;
+
+// ------------------------ is_converting_kernel<...> --------------------- //
+template <typename T1, typename T2>
+struct _is_converting_kernel: std::integral_constant<bool,
+    !std::is_same<T1, T2>::value
+ && std::is_arithmetic<T1>::value && !std::is_same<T1, bool>::value
+ && std::is_arithmetic<T2>::value && !std::is_same<T2, bool>::value
+ && _is_kernel<typename std::common_type<T1, T2>::type>::value
+> {};
+
+template <typename T1, typename T2>
+struct is_converting_kernel: std::enable_if<_is_converting_kernel<T1, T2>::value, bool> {};
+
+template <typename T1, typename T2>
+struct is_generic_kernel: std::enable_if<!_is_converting_kernel<T1, T2>::value, bool> {};
+
+/* Syntax: vtool::simd::_converted(kernel, T1* dst, const T2* src, std::size_t N);
+ * Return: None. Runs "kernel" of the common type C over "N" elements, with
+ *         "dst" read in place when it already holds C.
+ */
+template <typename C, typename T2>
+inline void
+_converted(void (*kernel)(C*, const C*, std::size_t), C* dst, const T2* src, const std::size_t N)
+{
+    C rhs_buf[_convert_block];
+
+    for (std::size_t pos = 0; pos < N; pos += _convert_block)
+    {
+        const std::size_t count = std::min(_convert_block, N - pos);
+
+        for (std::size_t n = 0; n < count; ++n)
+            rhs_buf[n] = static_cast<C>(src[pos + n]);
+        kernel(dst + pos, rhs_buf, count);
+    }
+}
+
+template <typename C, typename T1, typename T2>
+inline void
+_converted(void (*kernel)(C*, const C*, std::size_t), T1* dst, const T2* src, const std::size_t N)
+{
+    C lhs_buf[_convert_block];
+    C rhs_buf[_convert_block];
+
+    for (std::size_t pos = 0; pos < N; pos += _convert_block)
+    {
+        const std::size_t count = std::min(_convert_block, N - pos);
+
+        for (std::size_t n = 0; n < count; ++n)
+        {
+            lhs_buf[n] = static_cast<C>(dst[pos + n]);
+            rhs_buf[n] = static_cast<C>(src[pos + n]);
+        }
+        kernel(lhs_buf, rhs_buf, count);
+
+        for (std::size_t n = 0; n < count; ++n)
+            dst[pos + n] = static_cast<T1>(lhs_buf[n]);
+    }
+}
+
+#ifdef _CXX20_FLAG
+#   define _vtool_constant_evaluated() std::is_constant_evaluated()
+#else
+#   define _vtool_constant_evaluated() false
+#endif
+
+#define _VTOOL_COMPOUND_KERNEL(_name, _op)                                  \
+template <typename T1, typename T2, typename Alloc1, typename Alloc2,       \
+          typename is_generic_kernel<T1, T2>::type = true>                  \
+_CXX20_CONSTEXPR                                                            \
+void                                                                        \
+_name(std::vector<T1, Alloc1>& lhv, const std::vector<T2, Alloc2>& rhv)     \
+{                                                                           \
+    typename std::vector<T1, Alloc1>::iterator lIter = lhv.begin();         \
+    typename std::vector<T2, Alloc2>::const_iterator rIter = rhv.cbegin();  \
+                                                                            \
+    if (_vtool_constant_evaluated())                                        \
+        for (std::size_t n = 0; n < lhv.size(); ++n) lIter[n] _op rIter[n]; \
+    else                                                                    \
+        vtool::parallel::for_each_range(lhv.size(), sizeof(T1),             \
+            [&](const std::size_t begin, const std::size_t end){            \
+                for (std::size_t n = begin; n < end; ++n)                   \
+                    lIter[n] _op rIter[n];                                  \
+            });                                                             \
+}                                                                           \
+                                                                            \
+template <typename T, typename Alloc1, typename Alloc2,                     \
+          typename is_kernel<T>::type = true>                               \
+_CXX20_CONSTEXPR                                                            \
+void                                                                        \
+_name(std::vector<T, Alloc1>& lhv, const std::vector<T, Alloc2>& rhv)       \
+{                                                                           \
+    if (_vtool_constant_evaluated())                                        \
+        for (std::size_t n = 0; n < lhv.size(); ++n) lhv[n] _op rhv[n];     \
+    else                                                                    \
+    {                                                                       \
+        void (*kernel)(T*, const T*, std::size_t)                           \
+            = _active_kernels<T>()._name;                                   \
+        T* dst = lhv.data();                                                \
+        const T* src = rhv.data();                                          \
+                                                                            \
+        vtool::parallel::for_each_range(lhv.size(), sizeof(T),              \
+            [=](const std::size_t begin, const std::size_t end){            \
+                kernel(dst + begin, src + begin, end - begin);              \
+            });                                                             \
+    }                                                                       \
+}                                                                           \
+                                                                            \
+template <typename T1, typename T2, typename Alloc1, typename Alloc2,       \
+          typename is_converting_kernel<T1, T2>::type = true>               \
+_CXX20_CONSTEXPR                                                            \
+void                                                                        \
+_name(std::vector<T1, Alloc1>& lhv, const std::vector<T2, Alloc2>& rhv)     \
+{                                                                           \
+    using C = typename std::common_type<T1, T2>::type;                      \
+                                                                            \
+    if (_vtool_constant_evaluated())                                        \
+        for (std::size_t n = 0; n < lhv.size(); ++n) lhv[n] _op rhv[n];     \
+    else                                                                    \
+    {                                                                       \
+        void (*kernel)(C*, const C*, std::size_t)                           \
+            = _active_kernels<C>()._name;                                   \
+        T1* dst = lhv.data();                                               \
+        const T2* src = rhv.data();                                         \
+                                                                            \
+        vtool::parallel::for_each_range(lhv.size(), sizeof(T1),             \
+            [=](const std::size_t begin, const std::size_t end){            \
+                vtool::simd::_converted<C>(kernel, dst + begin,             \
+                                           src + begin, end - begin);       \
+            });                                                             \
+    }                                                                       \
+}
+
+_VTOOL_COMPOUND_KERNEL(add, +=)
+_VTOOL_COMPOUND_KERNEL(sub, -=)
+_VTOOL_COMPOUND_KERNEL(mul, *=)
+_VTOOL_COMPOUND_KERNEL(div, /=)
+
+#undef _VTOOL_COMPOUND_KERNEL
+#undef _vtool_constant_evaluated
+
+    }   // namespace simd
+}   // namespace vtool
+
+#undef _VTOOL_SIMD_X86
+#undef _VTOOL_TARGET_SSE2
+#undef _VTOOL_TARGET_AVX2
+#undef _VTOOL_TARGET_AVX512
+#undef _VTOOL_NO_CONTRACT
+
+#endif  // __VTOOL_SIMD_H__
@@ -0,0 +1,914 @@
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o -------------------------------------- o
+    Fused Descriptive Statistics in a Pass
+  o -------------------------------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VTOOL_STATS_H__
+#define __VTOOL_STATS_H__
+
+#include <map>
+#include <set>
+#include <cmath>
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <functional>
+#include <type_traits>
+
+#include "vtool_view.h"
+#include "vtool_traits.h"
+#include "vtool_parallel.h"
+
+namespace vtool {
+
+namespace stat {
+
+    // statistics selectable by vtool::describe<...>()
+    enum: unsigned
+    {
+        count    = 1u << 0,
+        sum      = 1u << 1,
+        mean     = 1u << 2,
+        variance = 1u << 3,
+        rms      = 1u << 4,
+        norm     = 1u << 5,
+        min      = 1u << 6,
+        max      = 1u << 7,
+        argmin   = 1u << 8,
+        argmax   = 1u << 9,
+
+        all      = (1u << 10) - 1,
+
+        // only computed over rolling windows, not part of "all"
+        median   = 1u << 10
+    };
+
+    // independent accumulators per statistic, wide enough for the
+    // compiler to keep them in one vector register each
+    static const std::size_t
+    lanes = 8;
+}   // namespace stat
+
+// ----------------------------- statistics<T> ---------------------------- //
+/*
+ * Result of vtool::describe(). Statistics that were not selected stay zero.
+ * "variance" is the population variance, "argmin" and "argmax" are the
+ * first positions of the extremes.
+ */
+template <typename T>
+struct statistics
+{
+    std::size_t count;
+
+    VTOOL_DBL sum;
+    VTOOL_DBL mean;
+    VTOOL_DBL variance;
+    VTOOL_DBL rms;
+    VTOOL_DBL norm;
+
+    T min;
+    T max;
+    std::size_t argmin;
+    std::size_t argmax;
+};
+
+/* Syntax: vtool::_describe<Mask>(iterator first, std::size_t N);
+ * Return: vtool::statistics of the "N" elements from "first", gathered in a
+ *         single pass over stat::lanes interleaved accumulators.
+ */
+template <unsigned Mask, typename T, typename It>
+statistics<T>
+_describe(const It first, const std::size_t N)
+{
+    const bool need_sum = (Mask & (stat::sum | stat::mean)) != 0;
+    const bool need_sq  = (Mask & (stat::rms | stat::norm)) != 0;
+    const bool need_var = (Mask & stat::variance) != 0;
+    const bool need_min = (Mask & (stat::min | stat::argmin)) != 0;
+    const bool need_max = (Mask & (stat::max | stat::argmax)) != 0;
+
+    const std::size_t L = stat::lanes;
+
+    statistics<T> stats = statistics<T>();
+    stats.count = N;
+
+    if (N == 0)
+        return stats;
+
+    // variance is accumulated around the first element to avoid cancellation
+    const VTOOL_DBL shift = static_cast<VTOOL_DBL>(first[0]);
+
+    VTOOL_DBL s[L] = {}, q[L] = {}, ds[L] = {}, dq[L] = {};
+    T mn[L], mx[L];
+    std::size_t imn[L], imx[L];
+
+    for (std::size_t l = 0; l < L; ++l)
+    {
+        mn[l] = mx[l] = first[0];
+        imn[l] = imx[l] = 0;
+    }
+
+    std::size_t n = 0;
+
+    for (; n + L <= N; n += L)
+        for (std::size_t l = 0; l < L; ++l)
+        {
+            const T value = first[n+l];
+            const VTOOL_DBL x = static_cast<VTOOL_DBL>(value);
+
+            if (need_sum) s[l] += x;
+            if (need_sq)  q[l] += x*x;
+            if (need_var) { ds[l] += x - shift; dq[l] += (x - shift)*(x - shift); }
+            if (need_min && value < mn[l]) { mn[l] = value; imn[l] = n+l; }
+            if (need_max && value > mx[l]) { mx[l] = value; imx[l] = n+l; }
+        }
+
+    for (std::size_t l = 0; n < N; ++n, ++l)
+    {
+        const T value = first[n];
+        const VTOOL_DBL x = static_cast<VTOOL_DBL>(value);
+
+        if (need_sum) s[l] += x;
+        if (need_sq)  q[l] += x*x;
+        if (need_var) { ds[l] += x - shift; dq[l] += (x - shift)*(x - shift); }
+        if (need_min && value < mn[l]) { mn[l] = value; imn[l] = n; }
+        if (need_max && value > mx[l]) { mx[l] = value; imx[l] = n; }
+    }
+
+    // lanes are folded in order, ties keep the lowest position
+    VTOOL_DBL S = 0, Q = 0, DS = 0, DQ = 0;
+
+    stats.min = mn[0]; stats.argmin = imn[0];
+    stats.max = mx[0]; stats.argmax = imx[0];
+
+    for (std::size_t l = 0; l < L; ++l)
+    {
+        S += s[l]; Q += q[l]; DS += ds[l]; DQ += dq[l];
+
+        if (mn[l] < stats.min || (mn[l] == stats.min && imn[l] < stats.argmin))
+        { stats.min = mn[l]; stats.argmin = imn[l]; }
+        if (mx[l] > stats.max || (mx[l] == stats.max && imx[l] < stats.argmax))
+        { stats.max = mx[l]; stats.argmax = imx[l]; }
+    }
+
+    const VTOOL_DBL count = static_cast<VTOOL_DBL>(N);
+
+    if (Mask & stat::sum)      stats.sum      = S;
+    if (Mask & stat::mean)     stats.mean     = S / count;
+    if (Mask & stat::variance) stats.variance = (DQ - DS*DS/count) / count;
+    if (Mask & stat::rms)      stats.rms      = std::sqrt(Q / count);
+    if (Mask & stat::norm)     stats.norm     = std::sqrt(Q);
+
+    if (!(Mask & stat::min))    stats.min    = T();
+    if (!(Mask & stat::max))    stats.max    = T();
+    if (!(Mask & stat::argmin)) stats.argmin = 0;
+    if (!(Mask & stat::argmax)) stats.argmax = 0;
+    if (!(Mask & stat::count))  stats.count  = 0;
+
+    return stats;
+}
+
+/* Syntax: vtool::describe<Mask=stat::all>(std::vector vec);
+ * Return: vtool::statistics of the elements in "vec" from a single pass.
+ *         Mask combines vtool::stat flags, e.g. stat::mean | stat::max,
+ *         and statistics left out of it are not computed at all.
+ */
+template <unsigned Mask = stat::all, typename T, typename Alloc,
+          typename vtool::is_arithmetic<T>::type = true>
+inline statistics<T>
+describe(const std::vector<T, Alloc>& vec)
+{
+    return vtool::_describe<Mask, T>(vec.data(), vec.size());
+}
+
+template <unsigned Mask = stat::all, typename T,
+          typename vtool::is_arithmetic<typename view<T>::value_type>::type = true>
+inline statistics<typename view<T>::value_type>
+describe(const view<T> vw)
+{
+    return vtool::_describe<Mask, typename view<T>::value_type>(vw.begin(), vw.size());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o -------------------------------- o
+    Streaming Statistics over Chunks
+  o -------------------------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+// ---------------------------- accumulator<T> ---------------------------- //
+/*
+ * Running count, sum, mean, variance, rms, norm, min and max of an unbounded
+ * stream in constant memory. Chunks are reduced with the same lane kernel as
+ * vtool::describe() and folded in with Chan's update of Welford's algorithm,
+ * which is also how two accumulators, e.g. one per thread, are merged.
+ */
+template <typename T>
+class accumulator
+{
+    std::size_t _count;
+    VTOOL_DBL _sum;
+    VTOOL_DBL _mean;
+    VTOOL_DBL _m2;      // sum of squared deviations from the mean
+    VTOOL_DBL _sumsq;
+    T _min;
+    T _max;
+
+    void
+    _combine(const std::size_t count, const VTOOL_DBL sum, const VTOOL_DBL m2,
+             const VTOOL_DBL sumsq, const T min, const T max)
+    {
+        if (count == 0)
+            return;
+
+        if (_count == 0)
+        {
+            _count = count; _sum = sum; _mean = sum / static_cast<VTOOL_DBL>(count);
+            _m2 = m2; _sumsq = sumsq; _min = min; _max = max;
+            return;
+        }
+
+        const VTOOL_DBL na = static_cast<VTOOL_DBL>(_count);
+        const VTOOL_DBL nb = static_cast<VTOOL_DBL>(count);
+        const VTOOL_DBL delta = sum / nb - _mean;
+
+        _count += count;
+        _sum   += sum;
+        _mean  += delta * nb / (na + nb);
+        _m2    += m2 + delta*delta * na * nb / (na + nb);
+        _sumsq += sumsq;
+        _min    = min < _min ? min : _min;
+        _max    = max > _max ? max : _max;
+    }
+
+  public:
+    using value_type = T;
+
+    accumulator()
+        : _count(0), _sum(0), _mean(0), _m2(0), _sumsq(0), _min(), _max() {}
+
+    /* Syntax: acc.push(arithmetic_type value);
+     * Return: Reference to "acc" with "value" added.
+     */
+    accumulator&
+    push(const T value)
+    {
+        const VTOOL_DBL x = static_cast<VTOOL_DBL>(value);
+        this->_combine(1, x, 0, x*x, value, value);
+        return *this;
+    }
+
+    /* Syntax: acc.push(std::vector chunk);
+     *         acc.push(vtool::view chunk);
+     * Return: Reference to "acc" with every element of "chunk" added.
+     */
+    accumulator&
+    push(const view<const T> chunk)
+    {
+        const statistics<T> stats = vtool::_describe<
+            stat::count | stat::sum | stat::variance | stat::norm | stat::min | stat::max, T
+        >(chunk.begin(), chunk.size());
+
+        this->_combine(stats.count, stats.sum,
+                       stats.variance * static_cast<VTOOL_DBL>(stats.count),
+                       stats.norm * stats.norm, stats.min, stats.max);
+        return *this;
+    }
+
+    /* Syntax: acc.merge(vtool::accumulator other);
+     * Return: Reference to "acc" as if it had also seen everything pushed to "other".
+     */
+    accumulator&
+    merge(const accumulator& other)
+    {
+        this->_combine(other._count, other._sum, other._m2,
+                       other._sumsq, other._min, other._max);
+        return *this;
+    }
+
+    void
+    reset() { *this = accumulator(); }
+
+    std::size_t
+    count() const { return _count; }
+
+    VTOOL_DBL
+    sum() const { return _sum; }
+
+    VTOOL_DBL
+    mean() const { return _mean; }
+
+    // population variance, like vtool::describe()
+    VTOOL_DBL
+    variance() const { return _count ? _m2 / static_cast<VTOOL_DBL>(_count) : 0; }
+
+    VTOOL_DBL
+    rms() const { return _count ? std::sqrt(_sumsq / static_cast<VTOOL_DBL>(_count)) : 0; }
+
+    VTOOL_DBL
+    norm() const { return std::sqrt(_sumsq); }
+
+    T
+    min() const { return _min; }
+
+    T
+    max() const { return _max; }
+};
+
+// ---------------------------- quantile_sketch --------------------------- //
+/*
+ * Approximate quantiles of a stream in the manner of DDSketch: values fall
+ * into logarithmic buckets gamma^(i-1) < |x| <= gamma^i, so every estimate
+ * is within "relative_accuracy" of a true sample at that rank. Once more
+ * than "max_bins" buckets are in use, the buckets nearest zero collapse
+ * into one, keeping the memory bounded and the upper quantiles exact to the
+ * accuracy. Sketches with the same parameters merge by adding counts.
+ */
+class quantile_sketch
+{
+    VTOOL_DBL _accuracy;
+    VTOOL_DBL _gamma;
+    VTOOL_DBL _log_gamma;
+    std::size_t _max_bins;
+
+    std::size_t _count;
+    std::size_t _zeros;
+    std::map<int, std::size_t> _positive;
+    std::map<int, std::size_t> _negative;   // keyed by the bucket of |x|
+
+    VTOOL_DBL _min;
+    VTOOL_DBL _max;
+
+    int
+    _key(const VTOOL_DBL magnitude) const
+    {
+        return static_cast<int>(std::ceil(std::log(magnitude) / _log_gamma));
+    }
+
+    VTOOL_DBL
+    _value(const int key) const
+    {
+        return 2 * std::pow(_gamma, static_cast<VTOOL_DBL>(key)) / (_gamma + 1);
+    }
+
+    // walks from the most negative bucket up to the most positive one
+    VTOOL_DBL
+    _at_rank(const VTOOL_DBL rank) const
+    {
+        std::size_t seen = 0;
+
+        for (auto it = _negative.rbegin(); it != _negative.rend(); ++it)
+            if (static_cast<VTOOL_DBL>(seen += it->second) > rank)
+                return -this->_value(it->first);
+
+        if (static_cast<VTOOL_DBL>(seen += _zeros) > rank)
+            return 0;
+
+        for (const auto& bin: _positive)
+            if (static_cast<VTOOL_DBL>(seen += bin.second) > rank)
+                return this->_value(bin.first);
+
+        return _max;
+    }
+
+    void
+    _collapse(std::map<int, std::size_t>& bins)
+    {
+        while (_positive.size() + _negative.size() > _max_bins && bins.size() > 1)
+        {
+            auto lowest = bins.begin();
+            std::next(lowest)->second += lowest->second;
+            bins.erase(lowest);
+        }
+    }
+
+  public:
+    explicit
+    quantile_sketch(const VTOOL_DBL relative_accuracy=0.01, const std::size_t max_bins=2048)
+        : _accuracy(relative_accuracy),
+          _gamma((1 + relative_accuracy) / (1 - relative_accuracy)),
+          _log_gamma(std::log(_gamma)), _max_bins(max_bins < 2 ? 2 : max_bins),
+          _count(0), _zeros(0), _min(0), _max(0)
+    {
+        if (!(relative_accuracy > 0 && relative_accuracy < 1))
+            throw std::domain_error("Invalid Relative Accuracy: must be in (0, 1)");
+    }
+
+    /* Syntax: sketch.push(arithmetic_type value);
+     * Return: Reference to "sketch" with "value" added. Infinities and NaN
+     *         have no bucket and throw std::domain_error.
+     */
+    template <typename T,
+              typename vtool::is_arithmetic<T>::type = true>
+    quantile_sketch&
+    push(const T value)
+    {
+        const VTOOL_DBL x = static_cast<VTOOL_DBL>(value);
+
+        if (!std::isfinite(x))
+            throw std::domain_error("Invalid Value: sketch values must be finite");
+
+        _min = _count == 0 || x < _min ? x : _min;
+        _max = _count == 0 || x > _max ? x : _max;
+        ++_count;
+
+        if (x > 0)      { ++_positive[this->_key(x)];  this->_collapse(_positive); }
+        else if (x < 0) { ++_negative[this->_key(-x)]; this->_collapse(_negative); }
+        else            ++_zeros;
+
+        return *this;
+    }
+
+    /* Syntax: sketch.push(std::vector chunk);
+     *         sketch.push(vtool::view chunk);
+     * Return: Reference to "sketch" with every element of "chunk" added.
+     */
+    template <typename T, typename Alloc,
+              typename vtool::is_arithmetic<T>::type = true>
+    quantile_sketch&
+    push(const std::vector<T, Alloc>& chunk)
+    {
+        for (const T value: chunk)
+            this->push(value);
+        return *this;
+    }
+
+    template <typename T,
+              typename vtool::is_arithmetic<typename view<T>::value_type>::type = true>
+    quantile_sketch&
+    push(const view<T> chunk)
+    {
+        for (const typename view<T>::value_type value: chunk)
+            this->push(value);
+        return *this;
+    }
+
+    /* Syntax: sketch.merge(vtool::quantile_sketch other);
+     * Return: Reference to "sketch" as if it had also seen everything pushed
+     *         to "other". Both must share the same relative accuracy.
+     */
+    quantile_sketch&
+    merge(const quantile_sketch& other)
+    {
+        if (other._gamma != _gamma)
+            throw std::invalid_argument("Invalid Sketch: relative accuracies differ");
+        if (other._count == 0)
+            return *this;
+
+        _min = _count == 0 || other._min < _min ? other._min : _min;
+        _max = _count == 0 || other._max > _max ? other._max : _max;
+        _count += other._count;
+        _zeros += other._zeros;
+
+        for (const auto& bin: other._positive) _positive[bin.first] += bin.second;
+        for (const auto& bin: other._negative) _negative[bin.first] += bin.second;
+
+        this->_collapse(_positive);
+        this->_collapse(_negative);
+        return *this;
+    }
+
+    /* Syntax: sketch.quantile(VTOOL_DBL q);
+     * Return: Estimate of the q-th quantile (0 <= q <= 1) of every value pushed so far.
+     */
+    VTOOL_DBL
+    quantile(const VTOOL_DBL q) const
+    {
+        if (!(q >= 0 && q <= 1))
+            throw std::domain_error("Invalid Quantile: q must be in [0, 1]");
+        if (_count == 0)
+            return 0;
+
+        const VTOOL_DBL estimate = this->_at_rank(q * static_cast<VTOOL_DBL>(_count - 1));
+        return estimate < _min ? _min : estimate > _max ? _max : estimate;
+    }
+
+    /* Syntax: sketch.quantiles(std::vector qs);
+     * Return: std::vector of the estimates of the quantiles in "qs".
+     */
+    std::vector<VTOOL_DBL>
+    quantiles(const std::vector<VTOOL_DBL>& qs) const
+    {
+        std::vector<VTOOL_DBL> quants;
+        quants.reserve(qs.size());
+
+        for (const VTOOL_DBL q: qs)
+            quants.push_back(this->quantile(q));
+        return quants;
+    }
+
+    VTOOL_DBL
+    relative_accuracy() const { return _accuracy; }
+
+    std::size_t
+    count() const { return _count; }
+
+    std::size_t
+    bins() const { return _positive.size() + _negative.size() + (_zeros != 0); }
+
+    VTOOL_DBL
+    min() const { return _min; }
+
+    VTOOL_DBL
+    max() const { return _max; }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o ------------------------- o
+    Rolling Window Statistics
+  o ------------------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Window k covers samples [k*step, k*step + window). Sum, mean, variance and
+ * rms slide in O(1) per sample and are recomputed from the window after
+ * every "window" slides, so rounding errors cannot pile up over long
+ * records. Min and max use a monotonic deque in O(1) amortized, the median
+ * a sorted multiset in O(log window).
+ */
+
+// -------------------------- _rolling_moments<T> ------------------------- //
+template <typename T>
+class _rolling_moments
+{
+    std::size_t _window;
+    std::size_t _count;
+    std::size_t _slides;
+    std::vector<T> _ring;
+    VTOOL_DBL _sum;
+    VTOOL_DBL _sumsq;
+    VTOOL_DBL _m2;      // sum of squared deviations from the window mean
+
+    void
+    _refresh()
+    {
+        VTOOL_DBL sum = 0, sumsq = 0, m2 = 0;
+
+        for (const T value: _ring)
+        {
+            const VTOOL_DBL x = static_cast<VTOOL_DBL>(value);
+            sum += x;
+            sumsq += x*x;
+        }
+
+        const VTOOL_DBL mean = sum / static_cast<VTOOL_DBL>(_window);
+        for (const T value: _ring)
+            m2 += (static_cast<VTOOL_DBL>(value) - mean) * (static_cast<VTOOL_DBL>(value) - mean);
+
+        _sum = sum; _sumsq = sumsq; _m2 = m2; _slides = 0;
+    }
+
+  public:
+    explicit _rolling_moments(const std::size_t window)
+        : _window(window), _count(0), _slides(0), _ring(window),
+          _sum(0), _sumsq(0), _m2(0) {}
+
+    void
+    push(const T value)
+    {
+        const VTOOL_DBL x = static_cast<VTOOL_DBL>(value);
+        T& slot = _ring[_count % _window];
+
+        if (_count < _window)
+        {
+            const VTOOL_DBL mean_old = _count ? _sum / static_cast<VTOOL_DBL>(_count) : 0;
+
+            slot = value;
+            _sum += x;
+            _sumsq += x*x;
+            _m2 += (x - mean_old) * (x - _sum / static_cast<VTOOL_DBL>(++_count));
+            return;
+        }
+
+        // Welford's update with one sample leaving and one entering
+        const VTOOL_DBL y = static_cast<VTOOL_DBL>(slot);
+        const VTOOL_DBL mean_old = _sum / static_cast<VTOOL_DBL>(_window);
+
+        slot = value;
+        ++_count;
+        _sum += x - y;
+        _sumsq += x*x - y*y;
+        _m2 += (x - y) * (x - _sum / static_cast<VTOOL_DBL>(_window) + y - mean_old);
+
+        if (++_slides == _window)
+            this->_refresh();
+    }
+
+    template <unsigned Stat>
+    VTOOL_DBL
+    value() const
+    {
+        const VTOOL_DBL w = static_cast<VTOOL_DBL>(_window);
+
+        return Stat == stat::sum  ? _sum
+             : Stat == stat::mean ? _sum / w
+             : Stat == stat::rms  ? std::sqrt(std::max<VTOOL_DBL>(_sumsq, 0) / w)
+             : std::max<VTOOL_DBL>(_m2, 0) / w;
+    }
+};
+
+// --------------------- _rolling_extreme<T, Compare> --------------------- //
+// monotonic deque of (position, value) in a ring of "window" slots
+template <typename T, typename Compare>
+class _rolling_extreme
+{
+    std::size_t _window;
+    std::size_t _count;
+    std::vector<std::pair<std::size_t, T>> _deque;
+    std::size_t _head;
+    std::size_t _size;
+
+  public:
+    explicit _rolling_extreme(const std::size_t window)
+        : _window(window), _count(0), _deque(window), _head(0), _size(0) {}
+
+    void
+    push(const T value)
+    {
+        if (_size && _deque[_head].first + _window <= _count)
+        {
+            _head = (_head + 1) % _window;
+            --_size;
+        }
+        while (_size && !Compare()(_deque[(_head + _size - 1) % _window].second, value))
+            --_size;
+
+        _deque[(_head + _size) % _window] = std::make_pair(_count++, value);
+        ++_size;
+    }
+
+    template <unsigned Stat>
+    T
+    value() const { return _deque[_head].second; }
+};
+
+// -------------------------- _rolling_median<T> -------------------------- //
+// "_mid" is the upper middle element of the sorted window
+template <typename T>
+class _rolling_median
+{
+    std::size_t _window;
+    std::size_t _count;
+    std::vector<T> _ring;
+    std::multiset<T> _sorted;
+    typename std::multiset<T>::const_iterator _mid;
+
+  public:
+    explicit _rolling_median(const std::size_t window)
+        : _window(window), _count(0), _ring(window), _sorted(), _mid(_sorted.end()) {}
+
+    _rolling_median(const _rolling_median& other)
+        : _window(other._window), _count(other._count), _ring(other._ring),
+          _sorted(other._sorted), _mid(_sorted.end())
+    {
+        if (_count >= _window)
+            _mid = std::next(_sorted.cbegin(), static_cast<std::ptrdiff_t>(_window / 2));
+    }
+
+    _rolling_median&
+    operator=(const _rolling_median& other)
+    {
+        if (this != &other)
+        {
+            _rolling_median copy(other);
+            _window = copy._window; _count = copy._count;
+            _ring.swap(copy._ring); _sorted.swap(copy._sorted);
+            _mid = _count >= _window ? copy._mid : _sorted.cend();
+        }
+        return *this;
+    }
+
+    void
+    push(const T value)
+    {
+        T& slot = _ring[_count % _window];
+
+        if (_count < _window)
+        {
+            slot = value;
+            _sorted.insert(value);
+            if (++_count == _window)
+                _mid = std::next(_sorted.cbegin(), static_cast<std::ptrdiff_t>(_window / 2));
+            return;
+        }
+
+        const T old = slot;
+        slot = value;
+        ++_count;
+
+        _sorted.insert(value);
+        if (value < *_mid) --_mid;
+        if (old <= *_mid)  ++_mid;
+        _sorted.erase(_sorted.lower_bound(old));
+    }
+
+    // lower median for even windows, like vtool::median()
+    template <unsigned Stat>
+    T
+    value() const { return _window % 2 ? *_mid : *std::prev(_mid); }
+};
+
+template <unsigned Stat, typename T>
+struct _rolling_engine
+{
+    static_assert(Stat == stat::sum || Stat == stat::mean || Stat == stat::variance
+               || Stat == stat::rms || Stat == stat::min  || Stat == stat::max
+               || Stat == stat::median,
+                  "vtool::rolling supports sum, mean, variance, rms, min, max and median");
+
+    using type = typename std::conditional<Stat == stat::min, _rolling_extreme<T, std::less<T>>,
+                 typename std::conditional<Stat == stat::max, _rolling_extreme<T, std::greater<T>>,
+                 typename std::conditional<Stat == stat::median, _rolling_median<T>,
+                                           _rolling_moments<T>>::type>::type>::type;
+    using value_type = typename std::conditional<
+        Stat == stat::min || Stat == stat::max || Stat == stat::median, T, VTOOL_DBL
+    >::type;
+};
+
+// --------------------------- rolling<Stat, T> --------------------------- //
+/*
+ * Streaming form of the rolling functions: chunks of any size are pushed in
+ * order and every window completed by a chunk is appended to the output, so
+ * a long record gives the same windows whether it arrives at once or in
+ * pieces. "Stat" is one of vtool::stat::sum, mean, variance, rms, min, max
+ * or median.
+ */
+template <unsigned Stat, typename T>
+class rolling
+{
+    using _engine_t = typename _rolling_engine<Stat, T>::type;
+
+    std::size_t _window;
+    std::size_t _step;
+    std::size_t _count;
+    std::size_t _next;      // position completing the next window
+    _engine_t _engine;
+
+  public:
+    using value_type = typename _rolling_engine<Stat, T>::value_type;
+
+    rolling(const std::size_t window, const std::size_t step=1)
+        : _window(window), _step(step), _count(0), _next(window - 1),
+          _engine(window ? window : 1)
+    {
+        if (window == 0 || step == 0)
+            throw std::invalid_argument("Invalid Window: window and step must be positive");
+    }
+
+    /* Syntax: roll.windows(std::size_t N);
+     * Return: Number of windows completed by pushing "N" more samples.
+     */
+    std::size_t
+    windows(const std::size_t N) const
+    {
+        return _count + N > _next ? (_count + N - 1 - _next) / _step + 1 : 0;
+    }
+
+    /* Syntax: roll._push(iterator first, std::size_t N, pointer out);
+     * Return: None. Pushes "N" samples and stores every completed window to "out".
+     */
+    template <typename It>
+    void
+    _push(It first, const std::size_t N, value_type* out)
+    {
+        for (std::size_t n = 0; n < N; ++n, ++first)
+        {
+            _engine.push(static_cast<T>(*first));
+
+            if (_count++ == _next)
+            {
+                *out++ = _engine.template value<Stat>();
+                _next += _step;
+            }
+        }
+    }
+
+    /* Syntax: roll.push(std::vector chunk, std::vector out);
+     *         roll.push(vtool::view chunk, std::vector out);
+     * Return: Number of windows appended to "out".
+     */
+    template <typename Alloc>
+    std::size_t
+    push(const view<const T> chunk, std::vector<value_type, Alloc>& out)
+    {
+        const std::size_t nOut = this->windows(chunk.size());
+        const std::size_t offset = out.size();
+
+        out.resize(offset + nOut);
+        this->_push(chunk.begin(), chunk.size(), out.data() + offset);
+        return nOut;
+    }
+
+    void
+    reset() { *this = rolling(_window, _step); }
+
+    std::size_t
+    window() const { return _window; }
+
+    std::size_t
+    step() const { return _step; }
+
+    std::size_t
+    count() const { return _count; }
+};
+
+/* Syntax: vtool::_rolling<Stat>(vtool::view vw, std::size_t window, std::size_t step);
+ * Return: std::vector of "Stat" over every window of "vw". Long inputs are cut
+ *         into fixed blocks of windows that are computed on the thread pool,
+ *         each block starting from its own first window.
+ */
+template <unsigned Stat, typename T>
+std::vector<typename rolling<Stat, T>::value_type>
+_rolling(const view<const T> vw, const std::size_t window, const std::size_t step)
+{
+    using R = typename rolling<Stat, T>::value_type;
+
+    const std::size_t N = vw.size();
+    const std::size_t nOut = rolling<Stat, T>(window, step).windows(N);
+    std::vector<R> roll_vec(nOut);
+
+    const auto run = [&](const std::size_t k0, const std::size_t k1){
+        rolling<Stat, T> roll(window, step);
+        roll._push(vw.begin() + static_cast<std::ptrdiff_t>(k0 * step),
+                   (k1 - 1) * step + window - k0 * step, roll_vec.data() + k0);
+    };
+
+    if (nOut == 0)
+        return roll_vec;
+    if (!vtool::parallel::enabled() || N < vtool::parallel::threshold())
+    {
+        run(0, nOut);
+        return roll_vec;
+    }
+
+    // every block covers at least 8 windows of samples to amortize its warm-up
+    const std::size_t block = std::max<std::size_t>(
+        vtool::parallel::parallel_c::chunk_bytes / sizeof(R), (8*window + step - 1) / step
+    );
+    const std::size_t nBlock = (nOut + block - 1) / block;
+    const std::function<void(std::size_t)> task = [&](const std::size_t b){
+        run(b * block, std::min(b * block + block, nOut));
+    };
+
+    if (vtool::parallel::num_threads() > 1)
+        vtool::parallel::pool()->run(nBlock, task);
+    else
+        for (std::size_t b = 0; b < nBlock; ++b) task(b);
+
+    return roll_vec;
+}
+
+template <unsigned Stat, typename T>
+using _rolling_value_t
+    = typename rolling<Stat, typename std::remove_cv<T>::type>::value_type;
+
+#define _ROLLING_FUNCTION(_name, _stat)                                     \
+template <typename T, typename Alloc,                                       \
+          typename vtool::is_arithmetic<T>::type = true>                    \
+inline std::vector<_rolling_value_t<_stat, T>>                              \
+_name(const std::vector<T, Alloc>& vec, const std::size_t window,           \
+      const std::size_t step=1)                                             \
+{                                                                           \
+    return vtool::_rolling<_stat, T>(view<const T>(vec), window, step);     \
+}                                                                           \
+                                                                            \
+template <typename T,                                                       \
+          typename vtool::is_arithmetic<                                    \
+              typename std::remove_cv<T>::type                              \
+          >::type = true>                                                   \
+inline std::vector<_rolling_value_t<_stat, T>>                              \
+_name(const view<T> vw, const std::size_t window, const std::size_t step=1) \
+{                                                                           \
+    return vtool::_rolling<_stat, typename std::remove_cv<T>::type>(        \
+        vw, window, step                                                    \
+    );                                                                      \
+}
+
+/* Syntax: vtool::rolling_sum(std::vector vec, std::size_t window, std::size_t step=1);
+ *         vtool::rolling_mean, rolling_variance, rolling_rms,
+ *         rolling_min, rolling_max, rolling_median (same arguments);
+ * Return: std::vector of the statistic over every window of "window" elements
+ *         of "vec" (or a vtool::view), one per "step" elements. Variance is
+ *         the population variance, median the lower median like vtool::median().
+ */
+_ROLLING_FUNCTION(rolling_sum,      stat::sum)
+_ROLLING_FUNCTION(rolling_mean,     stat::mean)
+_ROLLING_FUNCTION(rolling_variance, stat::variance)
+_ROLLING_FUNCTION(rolling_rms,      stat::rms)
+_ROLLING_FUNCTION(rolling_min,      stat::min)
+_ROLLING_FUNCTION(rolling_max,      stat::max)
+_ROLLING_FUNCTION(rolling_median,   stat::median)
+
+#undef _ROLLING_FUNCTION
+
+}   // namespace vtool
+
+#endif  // __VTOOL_STATS_H__
@@ -9,9 +9,12 @@
 #ifndef __VTOOL_TRAITS_H__
 #define __VTOOL_TRAITS_H__
 
+#include <string>
 #include <vector>
 #include <memory>
 #include <complex>
+#include <cstring>
+#include <utility>
 #include <stdexcept>
 #include <type_traits>
 
@@ -97,6 +100,59 @@ struct is_integral: std::enable_if<
     combination<std::is_integral<Ts>...>::value, bool
 > {};
 
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o ----------------------- o
+    Operand Length Checking
+  o ----------------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+// ------------------------------ has_size<X> ----------------------------- //
+template <typename X, typename = void>
+struct _has_size: std::false_type {};
+
+template <typename X>
+struct _has_size<X, decltype(void(std::declval<const X&>().size()))>: std::true_type {};
+
+template <typename L, typename R>
+_CXX20_CONSTEXPR
+inline bool
+_is_same_length(const L& lhv, const R& rhv, std::true_type)
+{
+    return lhv.size() == rhv.size();
+}
+
+template <typename L, typename R>
+_CXX20_CONSTEXPR
+inline bool
+_is_same_length(const L&, const R&, std::false_type)
+{
+    return true;
+}
+
+/* Syntax: vtool::_is_same_length(operand lhv, operand rhv);
+ * Return: Boolean value indicating whether the operands can be combined
+ *         element-wise. Scalars broadcast and always match.
+ */
+template <typename L, typename R>
+_CXX20_CONSTEXPR
+inline bool
+_is_same_length(const L& lhv, const R& rhv)
+{
+    return vtool::_is_same_length(lhv, rhv, std::integral_constant<bool,
+        _has_size<L>::value && _has_size<R>::value
+    >());
+}
+
+[[noreturn]]
+inline void
+throw_vector_length_error(const char *FuncName)
+{
+    throw std::length_error(
+        std::string("Invalid Vector Length: ").append(FuncName, std::strlen(FuncName))
+    );
+}
 
 }   // namespace vtool
 
@@ -13,16 +13,24 @@
 #include <vector>
 #include <complex>
 #include <cstddef>
+#include <cstdint>
 #include <type_traits>
 
 #include <memory>
 #include <cstring>
 
 #include <cmath>
+#include <limits>
 #include <numeric>
 #include <algorithm>
+#include <functional>
+#include <stdexcept>
 
+#include "vtool_simd.h"
+#include "vtool_view.h"
 #include "vtool_traits.h"
+#include "vtool_parallel.h"
+#include "vtool_expression.h"
 
 namespace vtool {
 
@@ -38,6 +46,161 @@ isSameSize(const std::vector<T1, Alloc1>& lhv, const std::vector<T2, Alloc2>& rh
     return lhv.size() == rhv.size();
 }
 
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o ------------------ o
+    Summation Policies
+  o ------------------ o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Passed as the last argument of sum, mean, norm and rms:
+ *   serial   - one running VTOOL_DBL over the elements in order, always on
+ *              the calling thread
+ *   lanes    - summation::width independent accumulators the compiler can
+ *              keep in SIMD registers, folded in order at the end
+ *   pairwise - blocks of summation::block elements summed with lanes,
+ *              then combined pairwise, error grows with log(N)
+ *   kahan    - Kahan-Neumaier compensated summation, error independent of N
+ * Every policy is deterministic for a given input. With a policy, norm and
+ * rms square the elements in VTOOL_DBL. The functions without a policy
+ * square in the element type instead, and split long inputs into the
+ * blocks of vtool::parallel::reduce_range() when parallel execution is on.
+ */
+namespace summation {
+
+    struct serial_t   {};
+    struct lanes_t    {};
+    struct pairwise_t {};
+    struct kahan_t    {};
+
+    static constexpr serial_t   serial   {};
+    static constexpr lanes_t    lanes    {};
+    static constexpr pairwise_t pairwise {};
+    static constexpr kahan_t    kahan    {};
+
+    static const std::size_t
+    width = 8;
+
+    static const std::size_t
+    block = 128;
+}   // namespace summation
+
+// --------------------------- is_summation<...> -------------------------- //
+template <typename P>
+struct _is_summation: std::integral_constant<bool,
+    std::is_same<P, summation::serial_t>::value   || std::is_same<P, summation::lanes_t>::value
+ || std::is_same<P, summation::pairwise_t>::value || std::is_same<P, summation::kahan_t>::value
+> {};
+
+template <typename P>
+struct is_summation: std::enable_if<_is_summation<P>::value, bool> {};
+
+template <typename P>
+struct is_not_summation: std::enable_if<!_is_summation<P>::value, bool> {};
+
+struct _identity
+{
+    template <typename T>
+    constexpr T
+    operator()(const T value) const
+    { return value; }
+};
+
+/* Syntax: vtool::_accumulate(iterator first, std::size_t N, UnaryOp op, summation policy);
+ * Return: Sum of op(first[0]) ... op(first[N-1]) in VTOOL_DBL.
+ */
+template <typename It, typename UnaryOp>
+_CXX20_CONSTEXPR
+VTOOL_DBL
+_accumulate(const It first, const std::size_t N, const UnaryOp& op, summation::serial_t)
+{
+    VTOOL_DBL SUM = 0;
+
+    for (std::size_t n = 0; n < N; ++n)
+        SUM += static_cast<VTOOL_DBL>(op(first[n]));
+
+    return SUM;
+}
+
+template <typename It, typename UnaryOp>
+_CXX20_CONSTEXPR
+VTOOL_DBL
+_accumulate(const It first, const std::size_t N, const UnaryOp& op, summation::lanes_t)
+{
+    const std::size_t L = summation::width;
+    const std::size_t body = N / L * L;
+    VTOOL_DBL acc[L] = {};
+
+    for (std::size_t n = 0; n < body; n += L)
+        for (std::size_t l = 0; l < L; ++l)
+            acc[l] += static_cast<VTOOL_DBL>(op(first[n+l]));
+
+    for (std::size_t l = 0; l < N - body; ++l)
+        acc[l] += static_cast<VTOOL_DBL>(op(first[body+l]));
+
+    VTOOL_DBL SUM = 0;
+
+    for (std::size_t l = 0; l < L; ++l)
+        SUM += acc[l];
+
+    return SUM;
+}
+
+template <typename It, typename UnaryOp>
+_CXX20_CONSTEXPR
+VTOOL_DBL
+_accumulate(const It first, const std::size_t N, const UnaryOp& op, summation::pairwise_t)
+{
+    if (N <= summation::block)
+        return vtool::_accumulate(first, N, op, summation::lanes);
+
+    // split on a block boundary so every leaf is a full block but the last
+    const std::size_t half = (N / summation::block + 1) / 2 * summation::block;
+
+    return vtool::_accumulate(first, half, op, summation::pairwise)
+         + vtool::_accumulate(first + half, N - half, op, summation::pairwise);
+}
+
+template <typename It, typename UnaryOp>
+_CXX20_CONSTEXPR
+VTOOL_DBL
+_accumulate(const It first, const std::size_t N, const UnaryOp& op, summation::kahan_t)
+{
+    VTOOL_DBL SUM = 0;
+    VTOOL_DBL comp = 0;
+
+    for (std::size_t n = 0; n < N; ++n)
+    {
+        const VTOOL_DBL value = static_cast<VTOOL_DBL>(op(first[n]));
+        const VTOOL_DBL total = SUM + value;
+
+        // Neumaier: recover the low-order bits of whichever operand was smaller
+        if ((SUM < 0 ? -SUM : SUM) >= (value < 0 ? -value : value))
+            comp += (SUM - total) + value;
+        else
+            comp += (value - total) + SUM;
+
+        SUM = total;
+    }
+    return SUM + comp;
+}
+
+/* Syntax: vtool::_elements(std::vector vec);
+ * Return: Pointer to the elements of "vec", or its const_iterator for
+ *         std::vector<bool>, which has no data(). Either is indexed alike.
+ */
+template <typename T, typename Alloc>
+inline const T*
+_elements(const std::vector<T, Alloc>& vec)
+{ return vec.data(); }
+
+template <typename Alloc>
+inline typename std::vector<bool, Alloc>::const_iterator
+_elements(const std::vector<bool, Alloc>& vec)
+{ return vec.cbegin(); }
+
 /* Syntax: vtool::sum(std::vector vec);
  * Return: Sum of the elements in the input vector.
  */
@@ -47,29 +210,34 @@ _CXX20_CONSTEXPR
 VTOOL_DBL
 sum(const std::vector<T, Alloc>& vec)
 {
-    VTOOL_DBL SUM = 0;
-    
-    for (const T value: vec)
-        SUM += static_cast<VTOOL_DBL>(value);
-    
-    return SUM;
+    const auto data = vtool::_elements(vec);
+
+    return vtool::parallel::reduce_range<VTOOL_DBL>(vec.size(), sizeof(T),
+        [=](const std::size_t begin, const std::size_t end){
+            VTOOL_DBL SUM = 0;
+            for (std::size_t n = begin; n < end; ++n) SUM += static_cast<VTOOL_DBL>(data[n]);
+            return SUM;
+        }, std::plus<VTOOL_DBL>());
 }
 
 /* Syntax: vtool::sum(std::vector vec, UnaryOp op);
  * Return: Sum of the operated elements in the input vector.
  */
 template <typename T, typename Alloc, typename UnaryOp,
-          typename vtool::is_arithmetic<T>::type = true>
+          typename vtool::is_arithmetic<T>::type = true,
+          typename vtool::is_not_summation<UnaryOp>::type = true>
 _CXX20_CONSTEXPR
 VTOOL_DBL
 sum(const std::vector<T, Alloc>& vec, const UnaryOp& op)
 {
-    VTOOL_DBL SUM = 0;
-    
-    for (const T value: vec)
-        SUM += static_cast<VTOOL_DBL>(op(value));
-    
-    return SUM;
+    const auto data = vtool::_elements(vec);
+
+    return vtool::parallel::reduce_range<VTOOL_DBL>(vec.size(), sizeof(T),
+        [=, &op](const std::size_t begin, const std::size_t end){
+            VTOOL_DBL SUM = 0;
+            for (std::size_t n = begin; n < end; ++n) SUM += static_cast<VTOOL_DBL>(op(data[n]));
+            return SUM;
+        }, std::plus<VTOOL_DBL>());
 }
 
 /* Syntax: vtool::mean(std::vector vec);
@@ -116,6 +284,69 @@ rms(const std::vector<T, Alloc>& vec)
     );
 }
 
+/* Syntax: vtool::sum(std::vector vec, [UnaryOp op,] summation policy);
+ *         vtool::mean(std::vector vec, summation policy);
+ *         vtool::norm(std::vector vec, summation policy);
+ *         vtool::rms(std::vector vec, summation policy);
+ * Return: Same statistics accumulated under vtool::summation::serial, lanes,
+ *         pairwise or kahan. Squares are taken in VTOOL_DBL.
+ */
+template <typename T, typename Alloc, typename Policy,
+          typename vtool::is_arithmetic<T>::type = true,
+          typename vtool::is_summation<Policy>::type = true>
+_CXX20_CONSTEXPR
+inline VTOOL_DBL
+sum(const std::vector<T, Alloc>& vec, const Policy policy)
+{
+    return vtool::_accumulate(vec.data(), vec.size(), _identity(), policy);
+}
+
+template <typename T, typename Alloc, typename UnaryOp, typename Policy,
+          typename vtool::is_arithmetic<T>::type = true,
+          typename vtool::is_summation<Policy>::type = true>
+_CXX20_CONSTEXPR
+inline VTOOL_DBL
+sum(const std::vector<T, Alloc>& vec, const UnaryOp& op, const Policy policy)
+{
+    return vtool::_accumulate(vec.data(), vec.size(), op, policy);
+}
+
+template <typename T, typename Alloc, typename Policy,
+          typename vtool::is_arithmetic<T>::type = true,
+          typename vtool::is_summation<Policy>::type = true>
+_CXX20_CONSTEXPR
+inline VTOOL_DBL
+mean(const std::vector<T, Alloc>& vec, const Policy policy)
+{
+    return vtool::sum(vec, policy) / static_cast<VTOOL_DBL>(vec.size());
+}
+
+template <typename T, typename Alloc, typename Policy,
+          typename vtool::is_arithmetic<T>::type = true,
+          typename vtool::is_summation<Policy>::type = true>
+inline VTOOL_DBL
+norm(const std::vector<T, Alloc>& vec, const Policy policy)
+{
+    return std::sqrt(
+        vtool::sum(vec, [](const T value){
+            return static_cast<VTOOL_DBL>(value)*value;
+        }, policy)
+    );
+}
+
+template <typename T, typename Alloc, typename Policy,
+          typename vtool::is_arithmetic<T>::type = true,
+          typename vtool::is_summation<Policy>::type = true>
+inline VTOOL_DBL
+rms(const std::vector<T, Alloc>& vec, const Policy policy)
+{
+    return std::sqrt(
+        vtool::sum(vec, [](const T value){
+            return static_cast<VTOOL_DBL>(value)*value;
+        }, policy) / static_cast<VTOOL_DBL>(vec.size())
+    );
+}
+
 /* Syntax: vtool::max(std::vector vec);
  * Return: Maximum value of the elements in the input vector.
  */
@@ -125,12 +356,14 @@ _CXX20_CONSTEXPR
 T
 max(const std::vector<T, Alloc>& vec)
 {
-    T MAX = vec[0];
+    const auto data = vtool::_elements(vec);
 
-    for (const T value: vec)
-        MAX = value > MAX ? value : MAX;
-
-    return MAX;
+    return vtool::parallel::reduce_range<T>(vec.size(), sizeof(T),
+        [=](const std::size_t begin, const std::size_t end){
+            T MAX = begin < end ? data[begin] : T();
+            for (std::size_t n = begin; n < end; ++n) MAX = data[n] > MAX ? data[n] : MAX;
+            return MAX;
+        }, [](const T lhs, const T rhs){ return rhs > lhs ? rhs : lhs; });
 }
 
 /* Syntax: vtool::min(std::vector vec);
@@ -142,18 +375,127 @@ _CXX20_CONSTEXPR
 T
 min(const std::vector<T, Alloc>& vec)
 {
-    T MIN = vec[0];
-
-    for (const T value: vec)
-        MIN = value < MIN ? value : MIN;
+    const auto data = vtool::_elements(vec);
 
-    return MIN;
+    return vtool::parallel::reduce_range<T>(vec.size(), sizeof(T),
+        [=](const std::size_t begin, const std::size_t end){
+            T MIN = begin < end ? data[begin] : T();
+            for (std::size_t n = begin; n < end; ++n) MIN = data[n] < MIN ? data[n] : MIN;
+            return MIN;
+        }, [](const T lhs, const T rhs){ return rhs < lhs ? rhs : lhs; });
 }
 
 #define _ABS(value) ((value) > 0 ? (value) : -(value))
 
+// ------------------------------- Selection ------------------------------ //
+/*
+ * Order statistics are found with std::nth_element (introselect) instead of
+ * a full sort. Several ranks share the partitioning work: the middle rank
+ * splits the range once and the ranks on either side only look at their half.
+ */
+
+/* Syntax: vtool::_multiselect(iterator base, iterator first, iterator last,
+ *                             pointer rank_first, pointer rank_last);
+ * Return: None. Every element whose position from "base" is one of the sorted,
+ *         unique ranks ends up where a full sort of [first, last) would put it.
+ */
+template <typename It>
+void
+_multiselect(const It base, const It first, const It last,
+             const std::size_t* rank_first, const std::size_t* rank_last)
+{
+    if (rank_first == rank_last)
+        return;
+
+    const std::size_t* const rank_mid = rank_first + (rank_last - rank_first)/2;
+    const It kth = base + static_cast<std::ptrdiff_t>(*rank_mid);
+
+    std::nth_element(first, kth, last);
+
+    vtool::_multiselect(base, first, kth, rank_first, rank_mid);
+    vtool::_multiselect(base, kth + 1, last, rank_mid + 1, rank_last);
+}
+
+/* Syntax: vtool::_quantile_rank(VTOOL_DBL q, std::size_t N);
+ * Return: Fractional position q*(N-1) of the q-th quantile in sorted order.
+ */
+inline VTOOL_DBL
+_quantile_rank(const VTOOL_DBL q, const std::size_t N)
+{
+    if (!(q >= 0 && q <= 1))
+        throw std::domain_error("Invalid Quantile: q must be in [0, 1]");
+    if (N == 0)
+        vtool::throw_vector_length_error("quantile");
+
+    return q * static_cast<VTOOL_DBL>(N - 1);
+}
+
+/* Syntax: vtool::_quantile(iterator first, std::size_t N, VTOOL_DBL q);
+ * Return: q-th quantile of the "N" elements from "first", linearly interpolated
+ *         between the two closest ranks. The elements are reordered.
+ */
+template <typename It>
+VTOOL_DBL
+_quantile(const It first, const std::size_t N, const VTOOL_DBL q)
+{
+    const VTOOL_DBL h = vtool::_quantile_rank(q, N);
+    const std::size_t lo = static_cast<std::size_t>(h);
+    const It last = first + static_cast<std::ptrdiff_t>(N);
+    const It kth = first + static_cast<std::ptrdiff_t>(lo);
+
+    std::nth_element(first, kth, last);
+
+    const VTOOL_DBL low = static_cast<VTOOL_DBL>(*kth);
+    const VTOOL_DBL frac = h - static_cast<VTOOL_DBL>(lo);
+
+    // everything after kth is not smaller, so the next rank is their minimum
+    if (frac == 0)
+        return low;
+
+    return low + frac * (static_cast<VTOOL_DBL>(*std::min_element(kth + 1, last)) - low);
+}
+
+/* Syntax: vtool::_quantiles(iterator first, std::size_t N, std::vector qs);
+ * Return: std::vector of the quantiles in "qs" in the given order, all taken
+ *         from one multi-rank selection. The elements are reordered.
+ */
+template <typename It>
+std::vector<VTOOL_DBL>
+_quantiles(const It first, const std::size_t N, const std::vector<VTOOL_DBL>& qs)
+{
+    std::vector<std::size_t> ranks;
+    ranks.reserve(2*qs.size());
+
+    for (const VTOOL_DBL q: qs)
+    {
+        const std::size_t lo = static_cast<std::size_t>(vtool::_quantile_rank(q, N));
+        ranks.push_back(lo);
+        ranks.push_back(lo + 1 < N ? lo + 1 : lo);
+    }
+
+    std::sort(ranks.begin(), ranks.end());
+    ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+
+    vtool::_multiselect(first, first, first + static_cast<std::ptrdiff_t>(N),
+                        ranks.data(), ranks.data() + ranks.size());
+
+    std::vector<VTOOL_DBL> quants(qs.size());
+
+    for (std::size_t i = 0; i < qs.size(); ++i)
+    {
+        const VTOOL_DBL h = qs[i] * static_cast<VTOOL_DBL>(N - 1);
+        const std::size_t lo = static_cast<std::size_t>(h);
+        const VTOOL_DBL low = static_cast<VTOOL_DBL>(first[lo]);
+        const VTOOL_DBL frac = h - static_cast<VTOOL_DBL>(lo);
+
+        quants[i] = frac == 0 ? low : low + frac * (static_cast<VTOOL_DBL>(first[lo+1]) - low);
+    }
+    return quants;
+}
+
 /* Syntax: vtool::median(std::vector vec);
- * Return: Median value of the elements in the input vector.
+ * Return: Median value of the elements in the input vector,
+ *         the lower of the two middle elements for even sizes.
  */
 template <typename T, typename Alloc,
           typename vtool::is_arithmetic<T>::type = true>
@@ -161,10 +503,138 @@ _CXX20_CONSTEXPR
 inline T
 median(const std::vector<T, Alloc>& vec)
 {
+    if (vec.empty())
+        vtool::throw_vector_length_error("median");
+
     std::vector<T, Alloc> med_vec(vec);
-    std::sort(med_vec.begin(), med_vec.end());
+    const auto kth = med_vec.begin() + (vec.size()/2 - (1-vec.size()%2));
+    std::nth_element(med_vec.begin(), kth, med_vec.end());
+
+    return *kth;
+}
+
+/* Syntax: vtool::median_inplace(std::vector vec);
+ * Return: Same as vtool::median without copying. "vec" is reordered.
+ */
+template <typename T, typename Alloc,
+          typename vtool::is_arithmetic<T>::type = true>
+_CXX20_CONSTEXPR
+inline T
+median_inplace(std::vector<T, Alloc>& vec)
+{
+    if (vec.empty())
+        vtool::throw_vector_length_error("median_inplace");
+
+    const auto kth = vec.begin() + (vec.size()/2 - (1-vec.size()%2));
+    std::nth_element(vec.begin(), kth, vec.end());
+
+    return *kth;
+}
+
+/* Syntax: vtool::quantile(std::vector vec, VTOOL_DBL q);
+ * Return: q-th quantile (0 <= q <= 1) of the elements in the input vector,
+ *         linearly interpolated like numpy.quantile.
+ */
+template <typename T, typename Alloc,
+          typename vtool::is_arithmetic<T>::type = true>
+inline VTOOL_DBL
+quantile(const std::vector<T, Alloc>& vec, const VTOOL_DBL q)
+{
+    std::vector<T, Alloc> quant_vec(vec);
+    return vtool::_quantile(quant_vec.begin(), quant_vec.size(), q);
+}
+
+/* Syntax: vtool::quantile_inplace(std::vector vec, VTOOL_DBL q);
+ * Return: Same as vtool::quantile without copying. "vec" is reordered.
+ */
+template <typename T, typename Alloc,
+          typename vtool::is_arithmetic<T>::type = true>
+inline VTOOL_DBL
+quantile_inplace(std::vector<T, Alloc>& vec, const VTOOL_DBL q)
+{
+    return vtool::_quantile(vec.begin(), vec.size(), q);
+}
+
+/* Syntax: vtool::quantiles(std::vector vec, std::vector qs);
+ * Return: std::vector of the quantiles in "qs" of the elements in the input
+ *         vector, e.g. vtool::quantiles(vec, {0.5, 0.9, 0.99, 0.999}).
+ */
+template <typename T, typename Alloc,
+          typename vtool::is_arithmetic<T>::type = true>
+inline std::vector<VTOOL_DBL>
+quantiles(const std::vector<T, Alloc>& vec, const std::vector<VTOOL_DBL>& qs)
+{
+    std::vector<T, Alloc> quant_vec(vec);
+    return vtool::_quantiles(quant_vec.begin(), quant_vec.size(), qs);
+}
+
+/* Syntax: vtool::quantiles_inplace(std::vector vec, std::vector qs);
+ * Return: Same as vtool::quantiles without copying. "vec" is reordered.
+ */
+template <typename T, typename Alloc,
+          typename vtool::is_arithmetic<T>::type = true>
+inline std::vector<VTOOL_DBL>
+quantiles_inplace(std::vector<T, Alloc>& vec, const std::vector<VTOOL_DBL>& qs)
+{
+    return vtool::_quantiles(vec.begin(), vec.size(), qs);
+}
+
+/* Syntax: vtool::abs_inplace(std::vector vec);
+ * Return: Reference to "vec" holding the absolute value of its elements.
+ */
+template <typename T, typename Alloc,
+          typename vtool::is_arithmetic<T>::type = true>
+_CXX20_CONSTEXPR
+std::vector<T, Alloc>&
+abs_inplace(std::vector<T, Alloc>& vec)
+{
+    T* const data = vec.data();
+
+    vtool::parallel::for_each_range(vec.size(), sizeof(T),
+        [=](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n) data[n] = _ABS(data[n]);
+        });
+    return vec;
+}
+
+/* Syntax: vtool::abs_into(std::vector vec, std::vector out);
+ * Return: Reference to "out" resized to "vec" and holding the absolute value
+ *         of its elements. The capacity of "out" is reused.
+ */
+template <typename T, typename Alloc, typename U, typename AllocU,
+          typename vtool::is_arithmetic<T, U>::type = true>
+_CXX20_CONSTEXPR
+std::vector<U, AllocU>&
+abs_into(const std::vector<T, Alloc>& vec, std::vector<U, AllocU>& out)
+{
+    out.resize(vec.size());
+    const T* const from = vec.data();
+    U* const data = out.data();
+
+    vtool::parallel::for_each_range(out.size(), sizeof(U),
+        [=](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n) data[n] = static_cast<U>(_ABS(from[n]));
+        });
+    return out;
+}
+
+#undef _ABS
+
+// speciallized for complex vector
+template <typename C, typename AllocC, typename U, typename AllocU,
+          typename vtool::is_arithmetic<U>::type = true>
+std::vector<U, AllocU>&
+abs_into(const std::vector<std::complex<C>, AllocC>& vec, std::vector<U, AllocU>& out)
+{
+    out.resize(vec.size());
+    const std::complex<C>* const cmplx = vec.data();
+    U* const data = out.data();
 
-    return med_vec[vec.size()/2 - (1-vec.size()%2)];
+    vtool::parallel::for_each_range(out.size(), sizeof(std::complex<C>),
+        [=](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n) data[n] = static_cast<U>(std::abs(cmplx[n]));
+        });
+    return out;
 }
 
 /* Syntax: vtool::abs(std::vector vec);
@@ -177,25 +647,20 @@ std::vector<T, Alloc>
 abs(const std::vector<T, Alloc>& vec)
 {
     std::vector<T, Alloc> abs_vec(vec);
-    for (T& value: abs_vec) value = _ABS(value);
+    vtool::abs_inplace(abs_vec);
 
     return abs_vec;
 }
 
-#undef _ABS
-
 // speciallized for complex vector
 template <typename C, typename AllocC,
           typename Alloc = std::allocator<C>>
 std::vector<C, Alloc>
 abs(const std::vector<std::complex<C>, AllocC>& vec)
 {
-    const std::size_t N = vec.size();
-    std::vector<C, Alloc> abs_vec(N, 0);
-    
-    for (std::size_t n = 0; n < N; ++n)
-        abs_vec[n] = std::abs(vec[n]);
-    
+    std::vector<C, Alloc> abs_vec;
+    vtool::abs_into(vec, abs_vec);
+
     return abs_vec;
 }
 
@@ -214,117 +679,1883 @@ differential(const std::vector<T, Alloc>& vec)
     return diff_vec;
 }
 
-/* Syntax: vtool::duplicate_append(std::vector vec, std::size_t num=1);
- * Return: std::vector appended with itself "num" times.
+/* Syntax: vtool::differential_inplace(std::vector vec);
+ * Return: Reference to "vec" holding the differential value of its elements.
  */
 template <typename T, typename Alloc>
 _CXX20_CONSTEXPR
-std::vector<T, Alloc>
-duplicate_append(const std::vector<T, Alloc>& vec, const std::size_t num=1)
+std::vector<T, Alloc>&
+differential_inplace(std::vector<T, Alloc>& vec)
 {
-    const std::size_t N = vec.size();
-    const std::size_t M = N * num;
-    std::vector<T, Alloc> dup_vec(M, 0);
+    std::adjacent_difference(vec.cbegin(), vec.cend(), vec.begin());
+    return vec;
+}
 
-    for (std::size_t n = 0; n < M; ++n)
-        dup_vec[n] = vec[n%N];
+/* Syntax: vtool::differential_into(std::vector vec, std::vector out);
+ * Return: Reference to "out" resized to "vec" and holding the differential
+ *         value of its elements. The capacity of "out" is reused.
+ */
+template <typename T, typename Alloc, typename U, typename AllocU>
+_CXX20_CONSTEXPR
+std::vector<U, AllocU>&
+differential_into(const std::vector<T, Alloc>& vec, std::vector<U, AllocU>& out)
+{
+    out.resize(vec.size());
+    std::adjacent_difference(vec.cbegin(), vec.cend(), out.begin());
 
-    return dup_vec;
+    return out;
 }
 
-/* Syntax: vtool::interleave(std::vector vec, std::size_t ch);
- * Return: std::vector with elements interleaved in periods of "ch".
+// --------------------------------- Scan --------------------------------- //
+struct _maximum
+{
+    template <typename T>
+    static constexpr T
+    apply(const T lhs, const T rhs)
+    { return !(rhs > lhs) ? lhs : rhs; }
+};
+
+struct _minimum
+{
+    template <typename T>
+    static constexpr T
+    apply(const T lhs, const T rhs)
+    { return !(rhs < lhs) ? lhs : rhs; }
+};
+
+/* Syntax: vtool::_scan_kernel<Op, T>::get();
+ * Return: Dispatched inclusive scan kernel of "Op" over T, or nullptr when
+ *         the scan runs the generic loop.
  */
-template <typename T, typename Alloc>
-std::vector<T, Alloc>
-interleave(const std::vector<T, Alloc>& vec, const std::size_t ch)
+template <typename Op, typename T, typename = void>
+struct _scan_kernel
 {
-    const std::size_t N = vec.size();
-    std::vector<T, Alloc> il_vec(N, 0);
+    static inline vtool::simd::_scan_fn<T>
+    get() { return nullptr; }
+};
 
-    for (std::size_t n = 0; n < N; ++n)
-        il_vec[n] = vec[n*ch - (N-1)*(n*ch/N)];
+template <typename T>
+struct _scan_kernel<_plus, T,
+    typename std::enable_if<vtool::simd::_is_blas_kernel<T>::value>::type>
+{
+    static inline vtool::simd::_scan_fn<T>
+    get() { return vtool::simd::_scan_kernels<T>().add; }
+};
 
-    return il_vec;
-}
+template <typename T>
+struct _scan_kernel<_maximum, T,
+    typename std::enable_if<vtool::simd::_is_blas_kernel<T>::value>::type>
+{
+    static inline vtool::simd::_scan_fn<T>
+    get() { return vtool::simd::_scan_kernels<T>().max; }
+};
 
-/* Syntax: vtool::apply(std::vector vec, UnaryOp fn);
- * Return: std::vector with elements applied "fn" from "vec".
+template <typename T>
+struct _scan_kernel<_minimum, T,
+    typename std::enable_if<vtool::simd::_is_blas_kernel<T>::value>::type>
+{
+    static inline vtool::simd::_scan_fn<T>
+    get() { return vtool::simd::_scan_kernels<T>().min; }
+};
+
+/* Syntax: vtool::_scan_block<Op>(pointer src, pointer dst, std::size_t N);
+ * Return: None. Stores the inclusive scan of "N" elements of "src" into "dst".
  */
-template <typename T, typename Alloc, typename UnaryOp>
-_CXX20_CONSTEXPR
-std::vector<T, Alloc>
-apply(const std::vector<T, Alloc>& vec, const UnaryOp& op)
+template <typename Op, typename T>
+void
+_scan_block(const T* const src, T* const dst, const std::size_t N)
 {
-    std::vector<T, Alloc> op_vec(vec);
-    
-    for (T& value: op_vec)
-        value = op(value);
+    const vtool::simd::_scan_fn<T> kernel = _scan_kernel<Op, T>::get();
 
-    return op_vec;
+    if (kernel)
+    {
+        kernel(src, dst, N);
+        return;
+    }
+    if (N == 0)
+        return;
+
+    dst[0] = src[0];
+    for (std::size_t n = 1; n < N; ++n)
+        dst[n] = Op::template apply<T>(dst[n-1], src[n]);
 }
 
-/* Syntax: vtool::vector_cast<value_type>(std::vector vec);
- * Return: std::vector with elements casted to the specified value_type.
+/* Syntax: vtool::_scan<Op>(pointer src, pointer dst, std::size_t N);
+ * Return: None. Stores the inclusive scan of "src" into "dst", which may be
+ *         "src" itself. Long inputs are scanned in two passes over fixed
+ *         blocks: every block is scanned on its own on the thread pool, then
+ *         the running total of the blocks before it is folded in.
  */
-template <typename To, typename From, typename AllocFrom,
-          typename AllocTo = vtool::rebinded_alloc<AllocFrom, To>,
-          typename std::enable_if<!std::is_same<To, From>::value, bool>::type = true>
-_CXX20_CONSTEXPR
-inline std::vector<To, AllocTo>
-vector_cast(const std::vector<From, AllocFrom>& vec)
+template <typename Op, typename T>
+void
+_scan(const T* const src, T* const dst, const std::size_t N)
 {
-    return std::vector<To, AllocTo>(vec.cbegin(), vec.cend());
+    if (!vtool::parallel::enabled() || N < vtool::parallel::threshold())
+    {
+        vtool::_scan_block<Op>(src, dst, N);
+        return;
+    }
+
+    const std::size_t block = std::max<std::size_t>(
+        vtool::parallel::parallel_c::chunk_bytes / sizeof(T), 1
+    );
+    const std::size_t nBlock = (N + block - 1) / block;
+    const auto run = [](const std::size_t nTask,
+                        const std::function<void(std::size_t)>& task){
+        if (vtool::parallel::num_threads() > 1)
+            vtool::parallel::pool()->run(nTask, task);
+        else
+            for (std::size_t t = 0; t < nTask; ++t) task(t);
+    };
+
+    run(nBlock, [=](const std::size_t b){
+        const std::size_t begin = b * block;
+        vtool::_scan_block<Op>(src + begin, dst + begin, std::min(block, N - begin));
+    });
+
+    // carry[b] combines the totals of every block before block b
+    std::vector<T> carry(nBlock);
+    for (std::size_t b = 1; b < nBlock; ++b)
+        carry[b] = b == 1 ? dst[block - 1]
+                          : Op::template apply<T>(carry[b-1], dst[b*block - 1]);
+
+    run(nBlock - 1, [&](const std::size_t t){
+        const std::size_t begin = (t + 1) * block;
+        const std::size_t end = std::min(begin + block, N);
+        const T c = carry[t + 1];
+
+        for (std::size_t n = begin; n < end; ++n)
+            dst[n] = Op::template apply<T>(c, dst[n]);
+    });
 }
 
-//specialized for same value type
+#define _SCAN_FUNCTION(_name, _op)                                          \
+template <typename T, typename Alloc, typename AllocOut,                    \
+          typename vtool::is_arithmetic<T>::type = true>                    \
+std::vector<T, AllocOut>&                                                   \
+_name##_into(const std::vector<T, Alloc>& vec,                              \
+             std::vector<T, AllocOut>& out)                                 \
+{                                                                           \
+    out.resize(vec.size());                                                 \
+    vtool::_scan<_op>(vec.data(), out.data(), vec.size());                  \
+                                                                            \
+    return out;                                                             \
+}                                                                           \
+                                                                            \
+template <typename T, typename Alloc,                                       \
+          typename vtool::is_arithmetic<T>::type = true>                    \
+inline std::vector<T, Alloc>&                                               \
+_name##_inplace(std::vector<T, Alloc>& vec)                                 \
+{                                                                           \
+    vtool::_scan<_op>(vec.data(), vec.data(), vec.size());                  \
+    return vec;                                                             \
+}                                                                           \
+                                                                            \
+template <typename T, typename Alloc,                                       \
+          typename vtool::is_arithmetic<T>::type = true>                    \
+std::vector<T, Alloc>                                                       \
+_name(const std::vector<T, Alloc>& vec)                                     \
+{                                                                           \
+    std::vector<T, Alloc> scan_vec(vec.get_allocator());                    \
+    vtool::_name##_into(vec, scan_vec);                                     \
+                                                                            \
+    return scan_vec;                                                        \
+}
+
+/* Syntax: vtool::cumsum(std::vector vec);
+ *         vtool::cumprod, cummax, cummin (same argument);
+ *         vtool::cumsum_inplace(std::vector vec);
+ *         vtool::cumsum_into(std::vector vec, std::vector out);
+ * Return: std::vector (or reference to "vec", "out") holding the running
+ *         sum, product, maximum or minimum of the elements in "vec".
+ *         vtool::differential() undoes vtool::cumsum(). Float and double
+ *         sums, maxima and minima run the dispatched SIMD scan kernels, so
+ *         rounding of the sums may differ from a serial loop in the last bits.
+ */
+_SCAN_FUNCTION(cumsum,  _plus)
+_SCAN_FUNCTION(cumprod, _multiplies)
+_SCAN_FUNCTION(cummax,  _maximum)
+_SCAN_FUNCTION(cummin,  _minimum)
+
+#undef _SCAN_FUNCTION
+
+// ----------------------------- Tile, Repeat ----------------------------- //
+/* Syntax: vtool::_tile_append(std::vector out, iterator first, std::size_t N, std::size_t reps);
+ * Return: None. Appends the "N" elements from "first" to "out" "reps" times
+ *         as block copies. Short periods are first tiled into a block of about
+ *         4 KiB, so that every append is one large copy rather than a few
+ *         elements, and no copy ever reads from "out" itself.
+ */
+template <typename T, typename Alloc, typename It>
+void
+_tile_append(std::vector<T, Alloc>& out, const It first, const std::size_t N, std::size_t reps)
+{
+    if (N == 0)
+        return;
+
+    const It last = first + static_cast<std::ptrdiff_t>(N);
+    const std::size_t per_block = 4096 / (N * sizeof(T));
+
+    if (per_block > 1 && reps > per_block)
+    {
+        std::vector<T, Alloc> block(out.get_allocator());
+        block.reserve(N * per_block);
+
+        for (std::size_t k = 0; k < per_block; ++k)
+            block.insert(block.end(), first, last);
+
+        for (; reps >= per_block; reps -= per_block)
+            out.insert(out.end(), block.cbegin(), block.cend());
+    }
+
+    for (; reps > 0; --reps)
+        out.insert(out.end(), first, last);
+}
+
+/* Syntax: vtool::tile(std::vector vec, std::size_t reps);
+ * Return: std::vector holding "vec" repeated "reps" times, like numpy.tile.
+ */
+template <typename T, typename Alloc>
+std::vector<T, Alloc>
+tile(const std::vector<T, Alloc>& vec, const std::size_t reps)
+{
+    std::vector<T, Alloc> tile_vec(vec.get_allocator());
+    tile_vec.reserve(vec.size() * reps);
+
+    vtool::_tile_append(tile_vec, vec.cbegin(), vec.size(), reps);
+    return tile_vec;
+}
+
+/* Syntax: vtool::repeat(std::vector vec, std::size_t reps);
+ * Return: std::vector holding every element of "vec" repeated "reps" times
+ *         in a row, like numpy.repeat, e.g. {1, 2} -> {1, 1, 2, 2}.
+ */
+template <typename T, typename Alloc>
+std::vector<T, Alloc>
+repeat(const std::vector<T, Alloc>& vec, const std::size_t reps)
+{
+    std::vector<T, Alloc> rep_vec(vec.get_allocator());
+    rep_vec.reserve(vec.size() * reps);
+
+    for (const T& value: vec)
+        rep_vec.insert(rep_vec.end(), reps, value);
+
+    return rep_vec;
+}
+
+/* Syntax: vtool::repeat(std::vector vec, std::vector<std::size_t> reps);
+ * Return: std::vector holding element n of "vec" repeated reps[n] times in a row.
+ */
+template <typename T, typename Alloc, typename AllocR>
+std::vector<T, Alloc>
+repeat(const std::vector<T, Alloc>& vec, const std::vector<std::size_t, AllocR>& reps)
+{
+    _vtool_length_check(vec, reps);
+
+    std::vector<T, Alloc> rep_vec(vec.get_allocator());
+    rep_vec.reserve(std::accumulate(reps.cbegin(), reps.cend(), std::size_t(0)));
+
+    for (std::size_t n = 0; n < vec.size(); ++n)
+        rep_vec.insert(rep_vec.end(), reps[n], vec[n]);
+
+    return rep_vec;
+}
+
+/* Syntax: vtool::duplicate_append(std::vector vec, std::size_t num=1);
+ * Return: std::vector appended with itself "num" times, same as vtool::tile.
+ */
+template <typename T, typename Alloc>
+inline std::vector<T, Alloc>
+duplicate_append(const std::vector<T, Alloc>& vec, const std::size_t num=1)
+{
+    return vtool::tile(vec, num);
+}
+
+// ---------------------------- Channel Layout ---------------------------- //
+/*
+ * vtool::interleave(vec, ch) reads "vec" as frames of "ch" samples and
+ * gathers every channel into one contiguous block, vtool::deinterleave puts
+ * the blocks back into frames. Same-typed contiguous buffers holding whole
+ * frames run the channel kernels over cache-sized tiles of frames, split
+ * across the thread pool. Other operands fall back to the index loops.
+ */
+
+// frames per tile of the generic channel loops, about 4 KiB of samples
+template <typename T>
+inline std::size_t
+_channel_tile(const std::size_t ch)
+{
+    return std::max<std::size_t>(4096 / (sizeof(T) * ch), 8);
+}
+
+/* Syntax: vtool::_split_range(pointer src, std::size_t ch, DstFn dst,
+ *                             std::size_t begin, std::size_t end, same_type);
+ * Return: None. Copies channel c of the frames [begin, end) in "src" to dst(c),
+ *         through the channel kernels when both sides share one value type.
+ */
+template <typename T, typename DstFn>
+void
+_split_range(const T* src, const std::size_t ch, const DstFn& dst,
+             const std::size_t begin, const std::size_t end, std::false_type)
+{
+    using U = typename std::remove_pointer<decltype(dst(0))>::type;
+    const std::size_t tile = vtool::_channel_tile<T>(ch);
+
+    for (std::size_t f0 = begin; f0 < end; f0 += tile)
+    {
+        const std::size_t f1 = std::min(f0 + tile, end);
+
+        for (std::size_t c = 0; c < ch; ++c)
+        {
+            U* const out = dst(c);
+            for (std::size_t f = f0; f < f1; ++f) out[f] = static_cast<U>(src[f*ch + c]);
+        }
+    }
+}
+
+template <std::size_t C, typename T, typename DstFn>
+inline void
+_split_fixed(const T* src, const DstFn& dst, const std::size_t begin, const std::size_t end)
+{
+    T* channel[C];
+    for (std::size_t c = 0; c < C; ++c) channel[c] = dst(c);
+
+    vtool::simd::_split_kernel<C, T>()(src, channel, begin, end);
+}
+
+template <typename T, typename DstFn>
+void
+_split_range(const T* src, const std::size_t ch, const DstFn& dst,
+             const std::size_t begin, const std::size_t end, std::true_type)
+{
+    switch (ch)
+    {
+        case 2:  vtool::_split_fixed<2>(src, dst, begin, end); break;
+        case 4:  vtool::_split_fixed<4>(src, dst, begin, end); break;
+        case 6:  vtool::_split_fixed<6>(src, dst, begin, end); break;
+        case 8:  vtool::_split_fixed<8>(src, dst, begin, end); break;
+        default: vtool::_split_range(src, ch, dst, begin, end, std::false_type());
+    }
+}
+
+/* Syntax: vtool::_merge_range(SrcFn src, std::size_t ch, pointer dst,
+ *                             std::size_t begin, std::size_t end, same_type);
+ * Return: None. Writes the frames [begin, end) built from the channels src(c) to "dst".
+ */
+template <typename SrcFn, typename U>
+void
+_merge_range(const SrcFn& src, const std::size_t ch, U* dst,
+             const std::size_t begin, const std::size_t end, std::false_type)
+{
+    const std::size_t tile = vtool::_channel_tile<U>(ch);
+
+    for (std::size_t f0 = begin; f0 < end; f0 += tile)
+    {
+        const std::size_t f1 = std::min(f0 + tile, end);
+
+        for (std::size_t c = 0; c < ch; ++c)
+        {
+            const auto in = src(c);
+            for (std::size_t f = f0; f < f1; ++f) dst[f*ch + c] = static_cast<U>(in[f]);
+        }
+    }
+}
+
+template <std::size_t C, typename SrcFn, typename T>
+inline void
+_merge_fixed(const SrcFn& src, T* dst, const std::size_t begin, const std::size_t end)
+{
+    const T* channel[C];
+    for (std::size_t c = 0; c < C; ++c) channel[c] = src(c);
+
+    vtool::simd::_merge_kernel<C, T>()(channel, dst, begin, end);
+}
+
+template <typename SrcFn, typename T>
+void
+_merge_range(const SrcFn& src, const std::size_t ch, T* dst,
+             const std::size_t begin, const std::size_t end, std::true_type)
+{
+    switch (ch)
+    {
+        case 2:  vtool::_merge_fixed<2>(src, dst, begin, end); break;
+        case 4:  vtool::_merge_fixed<4>(src, dst, begin, end); break;
+        case 6:  vtool::_merge_fixed<6>(src, dst, begin, end); break;
+        case 8:  vtool::_merge_fixed<8>(src, dst, begin, end); break;
+        default: vtool::_merge_range(src, ch, dst, begin, end, std::false_type());
+    }
+}
+
+/* Syntax: vtool::_split_channels(pointer src, std::size_t ch, std::size_t F, DstFn dst);
+ *         vtool::_merge_channels(SrcFn src, std::size_t ch, std::size_t F, pointer dst);
+ * Return: None. Moves the "F" frames of "ch" channels between "src" and the
+ *         channel buffers dst(c), or between src(c) and "dst", over the pool.
+ */
+template <typename T, typename DstFn>
+void
+_split_channels(const T* src, const std::size_t ch, const std::size_t F, const DstFn& dst)
+{
+    using U = typename std::remove_pointer<decltype(dst(0))>::type;
+
+    vtool::parallel::for_each_range(F, ch * sizeof(T),
+        [&](const std::size_t begin, const std::size_t end){
+            vtool::_split_range(src, ch, dst, begin, end, std::is_same<T, U>());
+        });
+}
+
+template <typename SrcFn, typename U>
+void
+_merge_channels(const SrcFn& src, const std::size_t ch, const std::size_t F, U* dst)
+{
+    using T = typename std::remove_cv<
+        typename std::remove_pointer<decltype(src(0))>::type
+    >::type;
+
+    vtool::parallel::for_each_range(F, ch * sizeof(U),
+        [&](const std::size_t begin, const std::size_t end){
+            vtool::_merge_range(src, ch, dst, begin, end, std::is_same<T, U>());
+        });
+}
+
+/* Syntax: vtool::_channel_count(std::size_t N, std::size_t ch, const char* FuncName);
+ * Return: Number of frames of "ch" samples in "N" elements. Throws
+ *         std::length_error unless "N" holds whole frames.
+ */
+inline std::size_t
+_channel_count(const std::size_t N, const std::size_t ch, const char* FuncName)
+{
+    if (ch == 0 || N % ch != 0)
+        vtool::throw_vector_length_error(FuncName);
+
+    return N / ch;
+}
+
+/* Syntax: vtool::_interleave(pointer src, pointer dst, std::size_t N, std::size_t ch);
+ *         vtool::_deinterleave(pointer src, pointer dst, std::size_t N, std::size_t ch);
+ * Return: None. Writes the "N" elements of "src" interleaved or deinterleaved
+ *         in periods of "ch" to "dst".
+ */
+template <typename T, typename U>
+void
+_interleave(const T* src, U* dst, const std::size_t N, const std::size_t ch)
+{
+    if (ch == 0 || N % ch != 0)
+    {
+        for (std::size_t n = 0; n < N; ++n)
+            dst[n] = static_cast<U>(src[n*ch - (N-1)*(n*ch/N)]);
+        return;
+    }
+
+    const std::size_t F = N / ch;
+    vtool::_split_channels(src, ch, F, [=](const std::size_t c){ return dst + c*F; });
+}
+
+template <typename T, typename U>
+void
+_deinterleave(const T* src, U* dst, const std::size_t N, const std::size_t ch)
+{
+    const std::size_t F = N / ch;
+    vtool::_merge_channels([=](const std::size_t c){ return src + c*F; }, ch, F, dst);
+}
+
+// std::vector<bool> has no data(), so it is only casted or permuted element-wise
+template <typename From, typename To>
+using _is_pointer_cast = std::integral_constant<
+    bool, !std::is_same<From, bool>::value && !std::is_same<To, bool>::value
+>;
+
+/* Syntax: vtool::_interleave_assign(std::vector vec, std::vector out, std::size_t ch, pointer_cast);
+ *         vtool::_deinterleave_assign(std::vector vec, std::vector out, std::size_t ch, pointer_cast);
+ * Return: None. Writes the elements of "vec" interleaved or deinterleaved in
+ *         periods of "ch" to "out", which already holds as many elements.
+ */
+template <typename T, typename Alloc, typename U, typename AllocU>
+inline void
+_interleave_assign(const std::vector<T, Alloc>& vec, std::vector<U, AllocU>& out,
+                   const std::size_t ch, std::true_type)
+{
+    vtool::_interleave(vec.data(), out.data(), vec.size(), ch);
+}
+
+template <typename T, typename Alloc, typename U, typename AllocU>
+inline void
+_interleave_assign(const std::vector<T, Alloc>& vec, std::vector<U, AllocU>& out,
+                   const std::size_t ch, std::false_type)
+{
+    const std::size_t N = vec.size();
+
+    for (std::size_t n = 0; n < N; ++n)
+        out[n] = static_cast<U>(vec[n*ch - (N-1)*(n*ch/N)]);
+}
+
+template <typename T, typename Alloc, typename U, typename AllocU>
+inline void
+_deinterleave_assign(const std::vector<T, Alloc>& vec, std::vector<U, AllocU>& out,
+                     const std::size_t ch, std::true_type)
+{
+    vtool::_deinterleave(vec.data(), out.data(), vec.size(), ch);
+}
+
+template <typename T, typename Alloc, typename U, typename AllocU>
+inline void
+_deinterleave_assign(const std::vector<T, Alloc>& vec, std::vector<U, AllocU>& out,
+                     const std::size_t ch, std::false_type)
+{
+    const std::size_t N = vec.size();
+
+    for (std::size_t n = 0; n < N; ++n)
+        out[n*ch - (N-1)*(n*ch/N)] = static_cast<U>(vec[n]);
+}
+
+/* Syntax: vtool::interleave(std::vector vec, std::size_t ch);
+ * Return: std::vector with elements interleaved in periods of "ch".
+ */
 template <typename T, typename Alloc>
+std::vector<T, Alloc>
+interleave(const std::vector<T, Alloc>& vec, const std::size_t ch)
+{
+    const std::size_t N = vec.size();
+    std::vector<T, Alloc> il_vec(N, 0);
+
+    vtool::_interleave_assign(vec, il_vec, ch, _is_pointer_cast<T, T>());
+    return il_vec;
+}
+
+/* Syntax: vtool::interleave_inplace(std::vector vec, std::size_t ch);
+ * Return: Reference to "vec" with its elements interleaved in periods of "ch".
+ *         The permutation goes through a per-thread scratch buffer whose
+ *         capacity is kept between calls.
+ */
+template <typename T, typename Alloc>
+std::vector<T, Alloc>&
+interleave_inplace(std::vector<T, Alloc>& vec, const std::size_t ch)
+{
+    static thread_local std::vector<T> scratch;
+    scratch.assign(vec.cbegin(), vec.cend());
+
+    vtool::_interleave_assign(scratch, vec, ch, _is_pointer_cast<T, T>());
+    return vec;
+}
+
+/* Syntax: vtool::interleave_into(std::vector vec, std::vector out, std::size_t ch);
+ * Return: Reference to "out" resized to "vec" and holding its elements
+ *         interleaved in periods of "ch". The capacity of "out" is reused.
+ */
+template <typename T, typename Alloc, typename U, typename AllocU>
+std::vector<U, AllocU>&
+interleave_into(const std::vector<T, Alloc>& vec, std::vector<U, AllocU>& out,
+                const std::size_t ch)
+{
+    if (static_cast<const void*>(&vec) == static_cast<const void*>(&out))
+        return vtool::interleave_inplace(out, ch);
+
+    out.resize(vec.size());
+    vtool::_interleave_assign(vec, out, ch, _is_pointer_cast<T, U>());
+
+    return out;
+}
+
+/* Syntax: vtool::interleave_into(std::vector vec, std::vector<std::vector> channels);
+ * Return: Reference to "channels", one buffer per channel of the frames in
+ *         "vec", each resized to the number of frames with its capacity reused.
+ *         The number of channels is channels.size().
+ */
+template <typename T, typename Alloc, typename U, typename AllocU, typename AllocC>
+std::vector<std::vector<U, AllocU>, AllocC>&
+interleave_into(const std::vector<T, Alloc>& vec,
+                std::vector<std::vector<U, AllocU>, AllocC>& channels)
+{
+    const std::size_t ch = channels.size();
+    const std::size_t F = vtool::_channel_count(vec.size(), ch, "interleave_into");
+    const T* const src = vec.data();
+
+    for (std::vector<U, AllocU>& channel: channels)
+        channel.resize(F);
+
+    vtool::_split_channels(src, ch, F,
+        [&](const std::size_t c){ return channels[c].data(); });
+    return channels;
+}
+
+/* Syntax: vtool::deinterleave(std::vector vec, std::size_t ch);
+ * Return: std::vector with the "ch" contiguous channel blocks of "vec" put
+ *         back into frames, the inverse of vtool::interleave(vec, ch).
+ */
+template <typename T, typename Alloc>
+std::vector<T, Alloc>
+deinterleave(const std::vector<T, Alloc>& vec, const std::size_t ch)
+{
+    const std::size_t N = vec.size();
+    vtool::_channel_count(N, ch, "deinterleave");
+
+    std::vector<T, Alloc> dil_vec(N, 0);
+    vtool::_deinterleave_assign(vec, dil_vec, ch, _is_pointer_cast<T, T>());
+
+    return dil_vec;
+}
+
+/* Syntax: vtool::deinterleave_inplace(std::vector vec, std::size_t ch);
+ * Return: Reference to "vec" deinterleaved in periods of "ch", permuted
+ *         through a per-thread scratch buffer kept between calls.
+ */
+template <typename T, typename Alloc>
+std::vector<T, Alloc>&
+deinterleave_inplace(std::vector<T, Alloc>& vec, const std::size_t ch)
+{
+    vtool::_channel_count(vec.size(), ch, "deinterleave_inplace");
+
+    static thread_local std::vector<T> scratch;
+    scratch.assign(vec.cbegin(), vec.cend());
+
+    vtool::_deinterleave_assign(scratch, vec, ch, _is_pointer_cast<T, T>());
+    return vec;
+}
+
+/* Syntax: vtool::deinterleave_into(std::vector vec, std::vector out, std::size_t ch);
+ * Return: Reference to "out" resized to "vec" and holding its elements
+ *         deinterleaved in periods of "ch". The capacity of "out" is reused.
+ */
+template <typename T, typename Alloc, typename U, typename AllocU>
+std::vector<U, AllocU>&
+deinterleave_into(const std::vector<T, Alloc>& vec, std::vector<U, AllocU>& out,
+                  const std::size_t ch)
+{
+    if (static_cast<const void*>(&vec) == static_cast<const void*>(&out))
+        return vtool::deinterleave_inplace(out, ch);
+
+    vtool::_channel_count(vec.size(), ch, "deinterleave_into");
+
+    out.resize(vec.size());
+    vtool::_deinterleave_assign(vec, out, ch, _is_pointer_cast<T, U>());
+
+    return out;
+}
+
+/* Syntax: vtool::deinterleave_into(std::vector<std::vector> channels, std::vector out);
+ * Return: Reference to "out" resized to hold the frames built from the
+ *         equally long "channels". The capacity of "out" is reused.
+ */
+template <typename T, typename Alloc, typename AllocC, typename U, typename AllocU>
+std::vector<U, AllocU>&
+deinterleave_into(const std::vector<std::vector<T, Alloc>, AllocC>& channels,
+                  std::vector<U, AllocU>& out)
+{
+    const std::size_t ch = channels.size();
+    const std::size_t F = ch ? channels[0].size() : 0;
+
+    for (const std::vector<T, Alloc>& channel: channels)
+        if (channel.size() != F)
+            vtool::throw_vector_length_error("deinterleave_into");
+
+    out.resize(ch * F);
+    vtool::_merge_channels([&](const std::size_t c){ return channels[c].data(); },
+                           ch, F, out.data());
+    return out;
+}
+
+/* Syntax: vtool::deinterleave(std::vector<std::vector> channels);
+ * Return: std::vector of the frames built from the equally long "channels".
+ */
+template <typename T, typename Alloc, typename AllocC>
+std::vector<T, Alloc>
+deinterleave(const std::vector<std::vector<T, Alloc>, AllocC>& channels)
+{
+    std::vector<T, Alloc> dil_vec;
+    vtool::deinterleave_into(channels, dil_vec);
+
+    return dil_vec;
+}
+
+/* Syntax: vtool::apply_inplace(std::vector vec, UnaryOp fn);
+ * Return: Reference to "vec" with "fn" applied to each of its elements.
+ */
+template <typename T, typename Alloc, typename UnaryOp>
 _CXX20_CONSTEXPR
-__forceinline std::vector<T, Alloc>
-vector_cast(const std::vector<T, Alloc>& vec)
+std::vector<T, Alloc>&
+apply_inplace(std::vector<T, Alloc>& vec, const UnaryOp& op)
 {
+    T* const data = vec.data();
+
+    vtool::parallel::for_each_range(vec.size(), sizeof(T),
+        [&](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n) data[n] = op(data[n]);
+        });
     return vec;
 }
 
-/* Syntax: vtool::linspace(arithmetic_type start, arithmetic_type stop, std::size_t num, bool endpoint);
- * Return: std::vector containing "num" values ranging from "start" to "stop".
- *         If endpoint is true, the returned vector includes the "stop" value.
- *         Otherwise, the "stop" value is excluded from the returned vector.
+/* Syntax: vtool::apply_into(std::vector vec, std::vector out, UnaryOp fn);
+ * Return: Reference to "out" resized to "vec" and holding its elements
+ *         applied "fn". The capacity of "out" is reused.
  */
-template <typename T1, typename T2,
-          typename Alloc = std::allocator<VTOOL_DBL>,
-          typename vtool::is_arithmetic<T1, T2>::type = true>
+template <typename T, typename Alloc, typename U, typename AllocU, typename UnaryOp>
 _CXX20_CONSTEXPR
-std::vector<VTOOL_DBL, Alloc>
-linspace(const T1 start, const T2 stop, const std::size_t num,
-         const bool endpoint=true)
+std::vector<U, AllocU>&
+apply_into(const std::vector<T, Alloc>& vec, std::vector<U, AllocU>& out, const UnaryOp& op)
 {
-    const std::size_t  D = num - static_cast<std::size_t>(endpoint);
-    const VTOOL_DBL step = (stop - start) /
-                            static_cast<VTOOL_DBL>(D + (D==0));
-    std::vector<VTOOL_DBL, Alloc> lin_vec(num, 0);
+    out.resize(vec.size());
+    const T* const from = vec.data();
+    U* const data = out.data();
+
+    vtool::parallel::for_each_range(out.size(), sizeof(U),
+        [&](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n) data[n] = op(from[n]);
+        });
+    return out;
+}
 
-    for (std::size_t n = 0; n < num; ++n)
-        lin_vec[n] = static_cast<VTOOL_DBL>(start + step*n);
+/* Syntax: vtool::apply(std::vector vec, UnaryOp fn);
+ * Return: std::vector with elements applied "fn" from "vec".
+ */
+template <typename T, typename Alloc, typename UnaryOp>
+_CXX20_CONSTEXPR
+std::vector<T, Alloc>
+apply(const std::vector<T, Alloc>& vec, const UnaryOp& op)
+{
+    std::vector<T, Alloc> op_vec(vec);
+    vtool::apply_inplace(op_vec, op);
 
-    return lin_vec;
+    return op_vec;
 }
 
 //////////////////////////////////////////////////////////////////////////////
 /*
-  o ------------------- o
-    Exception Functions
-  o ------------------- o
+  o ----------------- o
+    Sample Conversion
+  o ----------------- o
 */
 //////////////////////////////////////////////////////////////////////////////
 
-[[noreturn]]
-inline void
-throw_vector_length_error(const char *FuncName)
+/*
+ * Passed as the last argument of vector_cast and vector_cast_into, applied
+ * after the optional scale when the target value_type is an integer:
+ *   truncate - static_cast, rounds toward zero, overflow is undefined
+ *   round    - rounds to nearest even, overflow is undefined
+ *   saturate - rounds to nearest even and clamps to the target range,
+ *              NaN goes to the lowest value
+ * Floating targets are only scaled. int16 and int32 to float, and saturating
+ * float to int16 and int32 run the dispatched conversion kernels.
+ */
+namespace conversion {
+
+    struct truncate_t {};
+    struct round_t    {};
+    struct saturate_t {};
+
+    static constexpr truncate_t truncate {};
+    static constexpr round_t    round    {};
+    static constexpr saturate_t saturate {};
+}   // namespace conversion
+
+// -------------------------- is_conversion<...> -------------------------- //
+template <typename P>
+struct _is_conversion: std::integral_constant<bool,
+    std::is_same<P, conversion::truncate_t>::value || std::is_same<P, conversion::round_t>::value
+ || std::is_same<P, conversion::saturate_t>::value
+> {};
+
+template <typename P>
+struct is_conversion: std::enable_if<_is_conversion<P>::value, bool> {};
+
+// -------------------------------- int24_t ------------------------------- //
+/*
+ * Packed little-endian 24-bit sample without padding, so the buffer of a
+ * std::vector<vtool::int24_t> is a 24-bit PCM stream as is.
+ */
+struct int24_t
 {
-    throw std::length_error(
-        std::string("Invalid Vector Length: ").append(FuncName, std::strlen(FuncName))
-    );
+    unsigned char bytes[3];
+
+    int24_t() = default;
+
+    _CXX20_CONSTEXPR
+    int24_t(const std::int32_t value)
+        : bytes{static_cast<unsigned char>(static_cast<std::uint32_t>(value)),
+                static_cast<unsigned char>(static_cast<std::uint32_t>(value) >> 8),
+                static_cast<unsigned char>(static_cast<std::uint32_t>(value) >> 16)} {}
+
+    _CXX20_CONSTEXPR
+    operator std::int32_t() const
+    {
+        return (static_cast<std::int32_t>(bytes[0])
+              | static_cast<std::int32_t>(bytes[1]) << 8
+              | static_cast<std::int32_t>(bytes[2]) << 16)
+              - (static_cast<std::int32_t>(bytes[2] & 0x80) << 17);
+    }
+};
+
+template <typename T>
+struct _cast_limits
+{
+    static constexpr VTOOL_DBL lowest() { return static_cast<VTOOL_DBL>(std::numeric_limits<T>::lowest()); }
+    static constexpr VTOOL_DBL max()    { return static_cast<VTOOL_DBL>(std::numeric_limits<T>::max()); }
+};
+
+template <>
+struct _cast_limits<int24_t>
+{
+    static constexpr VTOOL_DBL lowest() { return -8388608; }
+    static constexpr VTOOL_DBL max()    { return  8388607; }
+};
+
+// scaled values are computed in the floating type among To and From
+template <typename From, typename To>
+using _cast_work_t = typename std::conditional<
+    std::is_floating_point<To>::value, To,
+    typename std::conditional<std::is_floating_point<From>::value, From, VTOOL_DBL>::type
+>::type;
+
+/* Syntax: vtool::_cast_value<To>(floating_type value, conversion policy, is_floating<To>);
+ * Return: "value" converted to To by "policy".
+ */
+template <typename To, typename W, typename Policy>
+inline To
+_cast_value(const W value, Policy, std::true_type)
+{
+    return static_cast<To>(value);
+}
+
+template <typename To, typename W>
+inline To
+_cast_value(const W value, conversion::truncate_t, std::false_type)
+{
+    return static_cast<To>(value);
+}
+
+template <typename To, typename W>
+inline To
+_cast_value(const W value, conversion::round_t, std::false_type)
+{
+    return static_cast<To>(std::nearbyint(value));
+}
+
+template <typename To, typename W>
+inline To
+_cast_value(const W value, conversion::saturate_t, std::false_type)
+{
+    return !(value > static_cast<W>(_cast_limits<To>::lowest())) ? static_cast<To>(_cast_limits<To>::lowest())
+         : value >= static_cast<W>(_cast_limits<To>::max())      ? static_cast<To>(_cast_limits<To>::max())
+         : static_cast<To>(std::nearbyint(value));
+}
+
+// ----------------------- _cast_kernel<From, To, P> ---------------------- //
+template <typename From, typename To, typename Policy>
+struct _cast_kernel
+{
+    static constexpr bool value = false;
+
+    static inline vtool::simd::_convert_fn<From, To>
+    get() { return nullptr; }
+};
+
+template <typename Policy>
+struct _cast_kernel<std::int16_t, float, Policy>
+{
+    static constexpr bool value = true;
+
+    static inline vtool::simd::_convert_fn<std::int16_t, float>
+    get() { return vtool::simd::_convert_kernels().i16_f32; }
+};
+
+template <typename Policy>
+struct _cast_kernel<std::int32_t, float, Policy>
+{
+    static constexpr bool value = true;
+
+    static inline vtool::simd::_convert_fn<std::int32_t, float>
+    get() { return vtool::simd::_convert_kernels().i32_f32; }
+};
+
+template <>
+struct _cast_kernel<float, std::int16_t, conversion::saturate_t>
+{
+    static constexpr bool value = true;
+
+    static inline vtool::simd::_convert_fn<float, std::int16_t>
+    get() { return vtool::simd::_convert_kernels().f32_i16; }
+};
+
+template <>
+struct _cast_kernel<float, std::int32_t, conversion::saturate_t>
+{
+    static constexpr bool value = true;
+
+    static inline vtool::simd::_convert_fn<float, std::int32_t>
+    get() { return vtool::simd::_convert_kernels().f32_i32; }
+};
+
+/* Syntax: vtool::_cast_range(pointer src, pointer dst, std::size_t N, [arithmetic_type scale, conversion policy]);
+ * Return: None. Stores the "N" elements of "src", times "scale" and converted
+ *         by "policy", into "dst". Without them it is a plain static_cast.
+ */
+template <typename From, typename To, typename Policy>
+void
+_cast_range(const From* const src, To* const dst, const std::size_t N,
+            const VTOOL_DBL scale, const Policy policy)
+{
+    using W = _cast_work_t<From, To>;
+
+    if (_cast_kernel<From, To, Policy>::value)
+    {
+        const vtool::simd::_convert_fn<From, To> kernel = _cast_kernel<From, To, Policy>::get();
+        const float fscale = static_cast<float>(scale);
+
+        vtool::parallel::for_each_range(N, sizeof(From),
+            [=](const std::size_t begin, const std::size_t end){
+                kernel(src + begin, dst + begin, fscale, end - begin);
+            });
+        return;
+    }
+
+    const W wscale = static_cast<W>(scale);
+
+    vtool::parallel::for_each_range(N, sizeof(From),
+        [=](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n)
+                dst[n] = vtool::_cast_value<To>(static_cast<W>(src[n]) * wscale, policy,
+                                                std::is_floating_point<To>());
+        });
+}
+
+template <typename From, typename To>
+inline void
+_cast_range(const From* const src, To* const dst, const std::size_t N, std::true_type)
+{
+    vtool::_cast_range(src, dst, N, 1, conversion::truncate);
+}
+
+template <typename From, typename To>
+void
+_cast_range(const From* const src, To* const dst, const std::size_t N, std::false_type)
+{
+    vtool::parallel::for_each_range(N, sizeof(From),
+        [=](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n) dst[n] = static_cast<To>(src[n]);
+        });
+}
+
+template <typename From, typename To>
+inline void
+_cast_range(const From* const src, To* const dst, const std::size_t N)
+{
+    vtool::_cast_range(src, dst, N, std::integral_constant<
+        bool, _cast_kernel<From, To, conversion::truncate_t>::value
+    >());
+}
+
+template <typename From, typename AllocFrom, typename To, typename AllocTo>
+inline void
+_cast_assign(const std::vector<From, AllocFrom>& vec, std::vector<To, AllocTo>& out,
+             std::true_type)
+{
+    out.resize(vec.size());
+    vtool::_cast_range(vec.data(), out.data(), out.size());
+}
+
+template <typename From, typename AllocFrom, typename To, typename AllocTo>
+inline void
+_cast_assign(const std::vector<From, AllocFrom>& vec, std::vector<To, AllocTo>& out,
+             std::false_type)
+{
+    out.assign(vec.cbegin(), vec.cend());
+}
+
+/* Syntax: vtool::vector_cast<value_type>(std::vector vec);
+ * Return: std::vector with elements casted to the specified value_type.
+ */
+template <typename To, typename From, typename AllocFrom,
+          typename AllocTo = vtool::rebinded_alloc<AllocFrom, To>,
+          typename std::enable_if<!std::is_same<To, From>::value, bool>::type = true>
+_CXX20_CONSTEXPR
+inline std::vector<To, AllocTo>
+vector_cast(const std::vector<From, AllocFrom>& vec)
+{
+    if (!vtool::parallel::is_parallel(vec.size()) && !_cast_kernel<From, To, conversion::truncate_t>::value)
+        return std::vector<To, AllocTo>(vec.cbegin(), vec.cend());
+
+    std::vector<To, AllocTo> cast_vec;
+    vtool::_cast_assign(vec, cast_vec, _is_pointer_cast<From, To>());
+
+    return cast_vec;
+}
+
+//specialized for same value type
+template <typename T, typename Alloc>
+__forceinline _CXX20_CONSTEXPR
+std::vector<T, Alloc>
+vector_cast(const std::vector<T, Alloc>& vec)
+{
+    return vec;
+}
+
+/* Syntax: vtool::vector_cast_into(std::vector vec, std::vector out);
+ * Return: Reference to "out" resized to "vec" and holding its elements casted
+ *         to the value_type of "out". The capacity of "out" is reused.
+ */
+template <typename From, typename AllocFrom, typename To, typename AllocTo>
+_CXX20_CONSTEXPR
+std::vector<To, AllocTo>&
+vector_cast_into(const std::vector<From, AllocFrom>& vec, std::vector<To, AllocTo>& out)
+{
+    vtool::_cast_assign(vec, out, _is_pointer_cast<From, To>());
+
+    return out;
+}
+
+/* Syntax: vtool::vector_cast_into(std::vector vec, std::vector out, [arithmetic_type scale,] conversion policy);
+ * Return: Reference to "out" resized to "vec" and holding its elements times
+ *         "scale" converted by "policy". The capacity of "out" is reused.
+ */
+template <typename From, typename AllocFrom, typename To, typename AllocTo,
+          typename S, typename Policy,
+          typename vtool::is_arithmetic<S>::type = true,
+          typename vtool::is_conversion<Policy>::type = true>
+std::vector<To, AllocTo>&
+vector_cast_into(const std::vector<From, AllocFrom>& vec, std::vector<To, AllocTo>& out,
+                 const S scale, const Policy policy)
+{
+    out.resize(vec.size());
+    vtool::_cast_range(vec.data(), out.data(), out.size(), static_cast<VTOOL_DBL>(scale), policy);
+
+    return out;
+}
+
+template <typename From, typename AllocFrom, typename To, typename AllocTo, typename Policy,
+          typename vtool::is_conversion<Policy>::type = true>
+inline std::vector<To, AllocTo>&
+vector_cast_into(const std::vector<From, AllocFrom>& vec, std::vector<To, AllocTo>& out,
+                 const Policy policy)
+{
+    return vtool::vector_cast_into(vec, out, 1, policy);
+}
+
+/* Syntax: vtool::vector_cast<value_type>(std::vector vec, [arithmetic_type scale,] conversion policy);
+ * Return: std::vector with the elements of "vec" times "scale" converted to
+ *         the specified value_type by "policy", e.g. float samples to
+ *         saturated int16 with scale 32767 and back with scale 1/32768.
+ */
+template <typename To, typename From, typename AllocFrom, typename S, typename Policy,
+          typename AllocTo = vtool::rebinded_alloc<AllocFrom, To>,
+          typename vtool::is_arithmetic<S>::type = true,
+          typename vtool::is_conversion<Policy>::type = true>
+std::vector<To, AllocTo>
+vector_cast(const std::vector<From, AllocFrom>& vec, const S scale, const Policy policy)
+{
+    std::vector<To, AllocTo> cast_vec(vec.size());
+    vtool::_cast_range(vec.data(), cast_vec.data(), vec.size(), static_cast<VTOOL_DBL>(scale), policy);
+
+    return cast_vec;
+}
+
+template <typename To, typename From, typename AllocFrom, typename Policy,
+          typename AllocTo = vtool::rebinded_alloc<AllocFrom, To>,
+          typename vtool::is_conversion<Policy>::type = true>
+inline std::vector<To, AllocTo>
+vector_cast(const std::vector<From, AllocFrom>& vec, const Policy policy)
+{
+    return vtool::vector_cast<To, From, AllocFrom, int, Policy, AllocTo>(vec, 1, policy);
+}
+
+/* Syntax: vtool::linspace(arithmetic_type start, arithmetic_type stop, std::size_t num, bool endpoint);
+ * Return: std::vector containing "num" values ranging from "start" to "stop".
+ *         If endpoint is true, the returned vector includes the "stop" value.
+ *         Otherwise, the "stop" value is excluded from the returned vector.
+ *         vtool::linspace_range yields the same values without the vector.
+ */
+template <typename T1, typename T2,
+          typename Alloc = std::allocator<VTOOL_DBL>,
+          typename vtool::is_arithmetic<T1, T2>::type = true>
+_CXX20_CONSTEXPR
+std::vector<VTOOL_DBL, Alloc>
+linspace(const T1 start, const T2 stop, const std::size_t num,
+         const bool endpoint=true)
+{
+    return vtool::_evaluate<std::vector<VTOOL_DBL, Alloc>>(
+        vtool::linspace_range(start, stop, num, endpoint)
+    );
+}
+
+/* Syntax: vtool::arange([arithmetic_type start,] arithmetic_type stop, [arithmetic_type step]);
+ * Return: std::vector containing the values from "start" (0) up to but
+ *         excluding "stop" in increments of "step" (1).
+ */
+template <typename T1, typename T2, typename T3 = int,
+          typename Alloc = std::allocator<typename std::common_type<T1, T2, T3>::type>,
+          typename vtool::is_arithmetic<T1, T2, T3>::type = true>
+std::vector<typename std::common_type<T1, T2, T3>::type, Alloc>
+arange(const T1 start, const T2 stop, const T3 step=1)
+{
+    return vtool::_evaluate<std::vector<typename std::common_type<T1, T2, T3>::type, Alloc>>(
+        vtool::arange_range(start, stop, step)
+    );
+}
+
+template <typename T, typename Alloc = std::allocator<T>,
+          typename vtool::is_arithmetic<T>::type = true>
+inline std::vector<T, Alloc>
+arange(const T stop)
+{
+    return vtool::arange<T, T, T, Alloc>(T(0), stop, T(1));
+}
+
+/* Syntax: vtool::logspace(arithmetic_type start, arithmetic_type stop, std::size_t num,
+ *                         bool endpoint=true, arithmetic_type base=10);
+ * Return: std::vector containing "num" values from base^start to base^stop.
+ */
+template <typename T1, typename T2, typename T3 = VTOOL_DBL,
+          typename Alloc = std::allocator<VTOOL_DBL>,
+          typename vtool::is_arithmetic<T1, T2, T3>::type = true>
+std::vector<VTOOL_DBL, Alloc>
+logspace(const T1 start, const T2 stop, const std::size_t num,
+         const bool endpoint=true, const T3 base=10)
+{
+    return vtool::_evaluate<std::vector<VTOOL_DBL, Alloc>>(
+        vtool::logspace_range(start, stop, num, endpoint, base)
+    );
+}
+
+/* Syntax: vtool::geomspace(arithmetic_type start, arithmetic_type stop, std::size_t num, bool endpoint=true);
+ * Return: std::vector containing "num" values from "start" to "stop" with a
+ *         constant ratio. Both bounds must be nonzero and share a sign.
+ */
+template <typename T1, typename T2,
+          typename Alloc = std::allocator<VTOOL_DBL>,
+          typename vtool::is_arithmetic<T1, T2>::type = true>
+std::vector<VTOOL_DBL, Alloc>
+geomspace(const T1 start, const T2 stop, const std::size_t num,
+          const bool endpoint=true)
+{
+    return vtool::_evaluate<std::vector<VTOOL_DBL, Alloc>>(
+        vtool::geomspace_range(start, stop, num, endpoint)
+    );
+}
+
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o --------------------------------- o
+    Utility Functions for vtool::view
+  o --------------------------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Same functions over a borrowed buffer. Results that need new storage are
+ * returned as std::vector, the *_into variants write into a caller-provided
+ * vtool::view of the same length instead.
+ */
+
+template <typename T>
+using _view_value_t = typename vtool::view<T>::value_type;
+
+/* Syntax: vtool::sum(vtool::view vw);
+ * Return: Sum of the elements in the input view.
+ */
+template <typename T,
+          typename vtool::is_arithmetic<_view_value_t<T>>::type = true>
+_CXX20_CONSTEXPR
+VTOOL_DBL
+sum(const vtool::view<T> vw)
+{
+    return vtool::parallel::reduce_range<VTOOL_DBL>(vw.size(), sizeof(_view_value_t<T>),
+        [=](const std::size_t begin, const std::size_t end){
+            VTOOL_DBL SUM = 0;
+            for (std::size_t n = begin; n < end; ++n) SUM += static_cast<VTOOL_DBL>(vw[n]);
+            return SUM;
+        }, std::plus<VTOOL_DBL>());
+}
+
+/* Syntax: vtool::sum(vtool::view vw, UnaryOp op);
+ * Return: Sum of the operated elements in the input view.
+ */
+template <typename T, typename UnaryOp,
+          typename vtool::is_arithmetic<_view_value_t<T>>::type = true,
+          typename vtool::is_not_summation<UnaryOp>::type = true>
+_CXX20_CONSTEXPR
+VTOOL_DBL
+sum(const vtool::view<T> vw, const UnaryOp& op)
+{
+    return vtool::parallel::reduce_range<VTOOL_DBL>(vw.size(), sizeof(_view_value_t<T>),
+        [=, &op](const std::size_t begin, const std::size_t end){
+            VTOOL_DBL SUM = 0;
+            for (std::size_t n = begin; n < end; ++n) SUM += static_cast<VTOOL_DBL>(op(vw[n]));
+            return SUM;
+        }, std::plus<VTOOL_DBL>());
+}
+
+/* Syntax: vtool::mean(vtool::view vw);
+ * Return: Mean value of the elements in the input view.
+ */
+template <typename T,
+          typename vtool::is_arithmetic<_view_value_t<T>>::type = true>
+_CXX20_CONSTEXPR
+inline VTOOL_DBL
+mean(const vtool::view<T> vw)
+{
+    return vtool::sum(vw) / static_cast<VTOOL_DBL>(vw.size());
+}
+
+/* Syntax: vtool::norm(vtool::view vw);
+ * Return: Magnitude of the input view.
+ */
+template <typename T,
+          typename vtool::is_arithmetic<_view_value_t<T>>::type = true>
+inline VTOOL_DBL
+norm(const vtool::view<T> vw)
+{
+    return std::sqrt(
+        vtool::sum(vw, [](const _view_value_t<T> value){
+            return value*value;
+        })
+    );
+}
+
+/* Syntax: vtool::rms(vtool::view vw);
+ * Return: Root mean square value of the elements in the input view.
+ */
+template <typename T,
+          typename vtool::is_arithmetic<_view_value_t<T>>::type = true>
+VTOOL_DBL
+rms(const vtool::view<T> vw)
+{
+    const size_t len = vw.size();
+
+    return std::sqrt(
+        vtool::sum(vw, [len](const _view_value_t<T> value){
+            return value*value / static_cast<VTOOL_DBL>(len);
+        })
+    );
+}
+
+/* Syntax: vtool::sum(vtool::view vw, [UnaryOp op,] summation policy);
+ *         vtool::mean(vtool::view vw, summation policy);
+ *         vtool::norm(vtool::view vw, summation policy);
+ *         vtool::rms(vtool::view vw, summation policy);
+ * Return: Same statistics accumulated under the given summation policy.
+ */
+template <typename T, typename Policy,
+          typename vtool::is_arithmetic<_view_value_t<T>>::type = true,
+          typename vtool::is_summation<Policy>::type = true>
+_CXX20_CONSTEXPR
+inline VTOOL_DBL
+sum(const vtool::view<T> vw, const Policy policy)
+{
+    return vtool::_accumulate(vw.begin(), vw.size(), _identity(), policy);
+}
+
+template <typename T, typename UnaryOp, typename Policy,
+          typename vtool::is_arithmetic<_view_value_t<T>>::type = true,
+          typename vtool::is_summation<Policy>::type = true>
+_CXX20_CONSTEXPR
+inline VTOOL_DBL
+sum(const vtool::view<T> vw, const UnaryOp& op, const Policy policy)
+{
+    return vtool::_accumulate(vw.begin(), vw.size(), op, policy);
+}
+
+template <typename T, typename Policy,
+          typename vtool::is_arithmetic<_view_value_t<T>>::type = true,
+          typename vtool::is_summation<Policy>::type = true>
+_CXX20_CONSTEXPR
+inline VTOOL_DBL
+mean(const vtool::view<T> vw, const Policy policy)
+{
+    return vtool::sum(vw, policy) / static_cast<VTOOL_DBL>(vw.size());
+}
+
+template <typename T, typename Policy,
+          typename vtool::is_arithmetic<_view_value_t<T>>::type = true,
+          typename vtool::is_summation<Policy>::type = true>
+inline VTOOL_DBL
+norm(const vtool::view<T> vw, const Policy policy)
+{
+    return std::sqrt(
+        vtool::sum(vw, [](const _view_value_t<T> value){
+            return static_cast<VTOOL_DBL>(value)*value;
+        }, policy)
+    );
+}
+
+template <typename T, typename Policy,
+          typename vtool::is_arithmetic<_view_value_t<T>>::type = true,
+          typename vtool::is_summation<Policy>::type = true>
+inline VTOOL_DBL
+rms(const vtool::view<T> vw, const Policy policy)
+{
+    return std::sqrt(
+        vtool::sum(vw, [](const _view_value_t<T> value){
+            return static_cast<VTOOL_DBL>(value)*value;
+        }, policy) / static_cast<VTOOL_DBL>(vw.size())
+    );
+}
+
+/* Syntax: vtool::max(vtool::view vw);
+ * Return: Maximum value of the elements in the input view.
+ */
+template <typename T,
+          typename vtool::is_arithmetic<_view_value_t<T>>::type = true>
+_CXX20_CONSTEXPR
+_view_value_t<T>
+max(const vtool::view<T> vw)
+{
+    using V = _view_value_t<T>;
+
+    return vtool::parallel::reduce_range<V>(vw.size(), sizeof(V),
+        [=](const std::size_t begin, const std::size_t end){
+            V MAX = begin < end ? vw[begin] : V();
+            for (std::size_t n = begin; n < end; ++n) MAX = vw[n] > MAX ? vw[n] : MAX;
+            return MAX;
+        }, [](const V lhs, const V rhs){ return rhs > lhs ? rhs : lhs; });
+}
+
+/* Syntax: vtool::min(vtool::view vw);
+ * Return: Minimum value of the elements in the input view.
+ */
+template <typename T,
+          typename vtool::is_arithmetic<_view_value_t<T>>::type = true>
+_CXX20_CONSTEXPR
+_view_value_t<T>
+min(const vtool::view<T> vw)
+{
+    using V = _view_value_t<T>;
+
+    return vtool::parallel::reduce_range<V>(vw.size(), sizeof(V),
+        [=](const std::size_t begin, const std::size_t end){
+            V MIN = begin < end ? vw[begin] : V();
+            for (std::size_t n = begin; n < end; ++n) MIN = vw[n] < MIN ? vw[n] : MIN;
+            return MIN;
+        }, [](const V lhs, const V rhs){ return rhs < lhs ? rhs : lhs; });
+}
+
+/* Syntax: vtool::median(vtool::view vw);
+ * Return: Median value of the elements in the input view.
+ */
+template <typename T,
+          typename vtool::is_arithmetic<_view_value_t<T>>::type = true>
+_CXX20_CONSTEXPR
+inline _view_value_t<T>
+median(const vtool::view<T> vw)
+{
+    return vtool::median(vtool::to_vector(vw));
+}
+
+/* Syntax: vtool::median_inplace(vtool::view vw);
+ *         vtool::quantile_inplace(vtool::view vw, VTOOL_DBL q);
+ *         vtool::quantiles_inplace(vtool::view vw, std::vector qs);
+ * Return: Same as the std::vector versions. The elements of "vw" are reordered.
+ */
+template <typename T,
+          typename vtool::is_arithmetic<T>::type = true,
+          typename std::enable_if<!std::is_const<T>::value, bool>::type = true>
+inline T
+median_inplace(const vtool::view<T> vw)
+{
+    if (vw.empty())
+        vtool::throw_vector_length_error("median_inplace");
+
+    const auto kth = vw.begin() + static_cast<std::ptrdiff_t>(vw.size()/2 - (1-vw.size()%2));
+    std::nth_element(vw.begin(), kth, vw.end());
+
+    return *kth;
+}
+
+template <typename T,
+          typename vtool::is_arithmetic<T>::type = true,
+          typename std::enable_if<!std::is_const<T>::value, bool>::type = true>
+inline VTOOL_DBL
+quantile_inplace(const vtool::view<T> vw, const VTOOL_DBL q)
+{
+    return vtool::_quantile(vw.begin(), vw.size(), q);
+}
+
+template <typename T,
+          typename vtool::is_arithmetic<T>::type = true,
+          typename std::enable_if<!std::is_const<T>::value, bool>::type = true>
+inline std::vector<VTOOL_DBL>
+quantiles_inplace(const vtool::view<T> vw, const std::vector<VTOOL_DBL>& qs)
+{
+    return vtool::_quantiles(vw.begin(), vw.size(), qs);
+}
+
+/* Syntax: vtool::quantile(vtool::view vw, VTOOL_DBL q);
+ *         vtool::quantiles(vtool::view vw, std::vector qs);
+ * Return: Quantiles of the elements in the input view, which is left untouched.
+ */
+template <typename T,
+          typename vtool::is_arithmetic<_view_value_t<T>>::type = true>
+inline VTOOL_DBL
+quantile(const vtool::view<T> vw, const VTOOL_DBL q)
+{
+    auto quant_vec = vtool::to_vector(vw);
+    return vtool::_quantile(quant_vec.begin(), quant_vec.size(), q);
+}
+
+template <typename T,
+          typename vtool::is_arithmetic<_view_value_t<T>>::type = true>
+inline std::vector<VTOOL_DBL>
+quantiles(const vtool::view<T> vw, const std::vector<VTOOL_DBL>& qs)
+{
+    auto quant_vec = vtool::to_vector(vw);
+    return vtool::_quantiles(quant_vec.begin(), quant_vec.size(), qs);
+}
+
+/* Syntax: vtool::abs_into(vtool::view vw, vtool::view out);
+ * Return: "out" holding the absolute value of the elements in "vw".
+ */
+template <typename T, typename U,
+          typename vtool::is_arithmetic<_view_value_t<T>>::type = true>
+vtool::view<U>
+abs_into(const vtool::view<T> vw, const vtool::view<U> out)
+{
+    _vtool_length_check(vw, out);
+
+    vtool::parallel::for_each_range(out.size(), sizeof(U),
+        [=](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n)
+                out[n] = static_cast<U>(vw[n] > 0 ? vw[n] : -vw[n]);
+        });
+    return out;
+}
+
+// speciallized for complex view
+template <typename C, typename U>
+vtool::view<U>
+abs_into(const vtool::view<const std::complex<C>> vw, const vtool::view<U> out)
+{
+    _vtool_length_check(vw, out);
+
+    vtool::parallel::for_each_range(out.size(), sizeof(std::complex<C>),
+        [=](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n)
+                out[n] = static_cast<U>(std::abs(vw[n]));
+        });
+    return out;
+}
+
+template <typename C, typename U>
+inline vtool::view<U>
+abs_into(const vtool::view<std::complex<C>> vw, const vtool::view<U> out)
+{
+    return vtool::abs_into(vtool::view<const std::complex<C>>(vw), out);
+}
+
+/* Syntax: vtool::abs_inplace(vtool::view vw);
+ * Return: "vw" holding the absolute value of its elements.
+ */
+template <typename T,
+          typename vtool::is_arithmetic<T>::type = true,
+          typename std::enable_if<!std::is_const<T>::value, bool>::type = true>
+inline vtool::view<T>
+abs_inplace(const vtool::view<T> vw)
+{
+    return vtool::abs_into(vw, vw);
+}
+
+/* Syntax: vtool::abs(vtool::view vw);
+ * Return: std::vector with the absolute value of the elements in the input view.
+ */
+template <typename T,
+          typename vtool::is_arithmetic<_view_value_t<T>>::type = true>
+std::vector<_view_value_t<T>>
+abs(const vtool::view<T> vw)
+{
+    std::vector<_view_value_t<T>> abs_vec(vw.size());
+    vtool::abs_into(vw, vtool::make_view(abs_vec));
+
+    return abs_vec;
+}
+
+// speciallized for complex view
+template <typename C>
+std::vector<C>
+abs(const vtool::view<const std::complex<C>> vw)
+{
+    std::vector<C> abs_vec(vw.size());
+    vtool::abs_into(vw, vtool::make_view(abs_vec));
+
+    return abs_vec;
+}
+
+template <typename C>
+inline std::vector<C>
+abs(const vtool::view<std::complex<C>> vw)
+{
+    return vtool::abs(vtool::view<const std::complex<C>>(vw));
+}
+
+/* Syntax: vtool::differential_into(vtool::view vw, vtool::view out);
+ * Return: "out" holding the differential value of the elements in "vw".
+ */
+template <typename T, typename U>
+vtool::view<U>
+differential_into(const vtool::view<T> vw, const vtool::view<U> out)
+{
+    _vtool_length_check(vw, out);
+
+    std::adjacent_difference(vw.begin(), vw.end(), out.begin());
+    return out;
+}
+
+/* Syntax: vtool::differential_inplace(vtool::view vw);
+ * Return: "vw" holding the differential value of its elements.
+ */
+template <typename T,
+          typename std::enable_if<!std::is_const<T>::value, bool>::type = true>
+inline vtool::view<T>
+differential_inplace(const vtool::view<T> vw)
+{
+    return vtool::differential_into(vw, vw);
+}
+
+/* Syntax: vtool::differential(vtool::view vw);
+ * Return: std::vector containing differential value of the elements
+ *         in the input view.
+ */
+template <typename T>
+std::vector<_view_value_t<T>>
+differential(const vtool::view<T> vw)
+{
+    std::vector<_view_value_t<T>> diff_vec(vw.size());
+    vtool::differential_into(vw, vtool::make_view(diff_vec));
+
+    return diff_vec;
+}
+
+#define _SCAN_FUNCTION(_name, _op)                                          \
+template <typename T, typename U,                                           \
+          typename std::enable_if<                                          \
+              std::is_same<_view_value_t<T>, U>::value, bool                \
+          >::type = true>                                                   \
+vtool::view<U>                                                              \
+_name##_into(const vtool::view<T> vw, const vtool::view<U> out)             \
+{                                                                           \
+    _vtool_length_check(vw, out);                                           \
+                                                                            \
+    if (vw.is_contiguous() && out.is_contiguous())                          \
+    {                                                                       \
+        vtool::_scan<_op>(vw.data(), out.data(), out.size());               \
+        return out;                                                         \
+    }                                                                       \
+    for (std::size_t n = 0; n < out.size(); ++n)                            \
+        out[n] = n ? _op::template apply<U>(out[n-1], vw[n]) : vw[n];       \
+                                                                            \
+    return out;                                                             \
+}                                                                           \
+                                                                            \
+template <typename T,                                                       \
+          typename std::enable_if<                                          \
+              !std::is_const<T>::value, bool                                \
+          >::type = true>                                                   \
+inline vtool::view<T>                                                       \
+_name##_inplace(const vtool::view<T> vw)                                    \
+{                                                                           \
+    return vtool::_name##_into(vw, vw);                                     \
+}                                                                           \
+                                                                            \
+template <typename T>                                                       \
+std::vector<_view_value_t<T>>                                               \
+_name(const vtool::view<T> vw)                                              \
+{                                                                           \
+    std::vector<_view_value_t<T>> scan_vec(vw.size());                      \
+    vtool::_name##_into(vw, vtool::make_view(scan_vec));                    \
+                                                                            \
+    return scan_vec;                                                        \
+}
+
+/* Syntax: vtool::cumsum(vtool::view vw);
+ *         vtool::cumprod, cummax, cummin (same argument);
+ *         vtool::cumsum_inplace(vtool::view vw);
+ *         vtool::cumsum_into(vtool::view vw, vtool::view out);
+ * Return: std::vector (or "vw", "out") holding the running sum, product,
+ *         maximum or minimum of the elements in "vw". Strided views are
+ *         scanned serially.
+ */
+_SCAN_FUNCTION(cumsum,  _plus)
+_SCAN_FUNCTION(cumprod, _multiplies)
+_SCAN_FUNCTION(cummax,  _maximum)
+_SCAN_FUNCTION(cummin,  _minimum)
+
+#undef _SCAN_FUNCTION
+
+/* Syntax: vtool::tile(vtool::view vw, std::size_t reps);
+ * Return: std::vector holding the elements of "vw" repeated "reps" times.
+ */
+template <typename T>
+std::vector<_view_value_t<T>>
+tile(const vtool::view<T> vw, const std::size_t reps)
+{
+    std::vector<_view_value_t<T>> tile_vec;
+    tile_vec.reserve(vw.size() * reps);
+
+    if (vw.is_contiguous())
+        vtool::_tile_append(tile_vec, vw.data(), vw.size(), reps);
+    else
+        vtool::_tile_append(tile_vec, vw.begin(), vw.size(), reps);
+
+    return tile_vec;
+}
+
+/* Syntax: vtool::repeat(vtool::view vw, std::size_t reps);
+ * Return: std::vector holding every element of "vw" repeated "reps" times in a row.
+ */
+template <typename T>
+std::vector<_view_value_t<T>>
+repeat(const vtool::view<T> vw, const std::size_t reps)
+{
+    std::vector<_view_value_t<T>> rep_vec;
+    rep_vec.reserve(vw.size() * reps);
+
+    for (const _view_value_t<T>& value: vw)
+        rep_vec.insert(rep_vec.end(), reps, value);
+
+    return rep_vec;
+}
+
+/* Syntax: vtool::duplicate_append(vtool::view vw, std::size_t num=1);
+ * Return: std::vector holding the elements of "vw" repeated "num" times.
+ */
+template <typename T>
+inline std::vector<_view_value_t<T>>
+duplicate_append(const vtool::view<T> vw, const std::size_t num=1)
+{
+    return vtool::tile(vw, num);
+}
+
+/* Syntax: vtool::interleave_into(vtool::view vw, vtool::view out, std::size_t ch);
+ * Return: "out" holding the elements of "vw" interleaved in periods of "ch".
+ */
+template <typename T, typename U>
+vtool::view<U>
+interleave_into(const vtool::view<T> vw, const vtool::view<U> out, const std::size_t ch)
+{
+    _vtool_length_check(vw, out);
+    const std::size_t N = vw.size();
+
+    if (vw.is_contiguous() && out.is_contiguous())
+    {
+        vtool::_interleave(static_cast<const _view_value_t<T>*>(vw.data()), out.data(), N, ch);
+        return out;
+    }
+
+    for (std::size_t n = 0; n < N; ++n)
+        out[n] = vw[n*ch - (N-1)*(n*ch/N)];
+
+    return out;
+}
+
+/* Syntax: vtool::interleave_inplace(vtool::view vw, std::size_t ch);
+ * Return: "vw" with its elements interleaved in periods of "ch", permuted
+ *         through a per-thread scratch buffer kept between calls.
+ */
+template <typename T,
+          typename std::enable_if<!std::is_const<T>::value, bool>::type = true>
+vtool::view<T>
+interleave_inplace(const vtool::view<T> vw, const std::size_t ch)
+{
+    static thread_local std::vector<T> scratch;
+    scratch.assign(vw.begin(), vw.end());
+
+    return vtool::interleave_into(vtool::view<const T>(scratch), vw, ch);
+}
+
+/* Syntax: vtool::interleave(vtool::view vw, std::size_t ch);
+ * Return: std::vector with elements interleaved in periods of "ch".
+ */
+template <typename T>
+std::vector<_view_value_t<T>>
+interleave(const vtool::view<T> vw, const std::size_t ch)
+{
+    std::vector<_view_value_t<T>> il_vec(vw.size());
+    vtool::interleave_into(vw, vtool::make_view(il_vec), ch);
+
+    return il_vec;
+}
+
+/* Syntax: vtool::deinterleave_into(vtool::view vw, vtool::view out, std::size_t ch);
+ * Return: "out" holding the elements of "vw" deinterleaved in periods of "ch".
+ */
+template <typename T, typename U>
+vtool::view<U>
+deinterleave_into(const vtool::view<T> vw, const vtool::view<U> out, const std::size_t ch)
+{
+    _vtool_length_check(vw, out);
+    const std::size_t N = vw.size();
+    const std::size_t F = vtool::_channel_count(N, ch, "deinterleave_into");
+
+    if (vw.is_contiguous() && out.is_contiguous())
+    {
+        vtool::_deinterleave(static_cast<const _view_value_t<T>*>(vw.data()), out.data(), N, ch);
+        return out;
+    }
+
+    for (std::size_t n = 0; n < N; ++n)
+        out[n] = vw[(n%ch)*F + n/ch];
+
+    return out;
+}
+
+/* Syntax: vtool::deinterleave_inplace(vtool::view vw, std::size_t ch);
+ * Return: "vw" deinterleaved in periods of "ch", permuted through a
+ *         per-thread scratch buffer kept between calls.
+ */
+template <typename T,
+          typename std::enable_if<!std::is_const<T>::value, bool>::type = true>
+vtool::view<T>
+deinterleave_inplace(const vtool::view<T> vw, const std::size_t ch)
+{
+    static thread_local std::vector<T> scratch;
+    scratch.assign(vw.begin(), vw.end());
+
+    return vtool::deinterleave_into(vtool::view<const T>(scratch), vw, ch);
+}
+
+/* Syntax: vtool::deinterleave(vtool::view vw, std::size_t ch);
+ * Return: std::vector with the elements of "vw" deinterleaved in periods of "ch".
+ */
+template <typename T>
+std::vector<_view_value_t<T>>
+deinterleave(const vtool::view<T> vw, const std::size_t ch)
+{
+    std::vector<_view_value_t<T>> dil_vec(vw.size());
+    vtool::deinterleave_into(vw, vtool::make_view(dil_vec), ch);
+
+    return dil_vec;
+}
+
+/* Syntax: vtool::apply_into(vtool::view vw, vtool::view out, UnaryOp fn);
+ * Return: "out" holding the elements of "vw" applied "fn".
+ */
+template <typename T, typename U, typename UnaryOp>
+vtool::view<U>
+apply_into(const vtool::view<T> vw, const vtool::view<U> out, const UnaryOp& op)
+{
+    _vtool_length_check(vw, out);
+
+    vtool::parallel::for_each_range(out.size(), sizeof(U),
+        [&](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n) out[n] = op(vw[n]);
+        });
+    return out;
+}
+
+/* Syntax: vtool::apply_inplace(vtool::view vw, UnaryOp fn);
+ * Return: "vw" with "fn" applied to each of its elements.
+ */
+template <typename T, typename UnaryOp,
+          typename std::enable_if<!std::is_const<T>::value, bool>::type = true>
+inline vtool::view<T>
+apply_inplace(const vtool::view<T> vw, const UnaryOp& op)
+{
+    return vtool::apply_into(vw, vw, op);
+}
+
+/* Syntax: vtool::apply(vtool::view vw, UnaryOp fn);
+ * Return: std::vector with elements applied "fn" from "vw".
+ */
+template <typename T, typename UnaryOp>
+std::vector<_view_value_t<T>>
+apply(const vtool::view<T> vw, const UnaryOp& op)
+{
+    std::vector<_view_value_t<T>> op_vec(vw.size());
+    vtool::apply_into(vw, vtool::make_view(op_vec), op);
+
+    return op_vec;
+}
+
+/* Syntax: vtool::vector_cast_into(vtool::view vw, vtool::view out);
+ * Return: "out" holding the elements of "vw" casted to its value_type.
+ */
+template <typename T, typename U>
+vtool::view<U>
+vector_cast_into(const vtool::view<T> vw, const vtool::view<U> out)
+{
+    _vtool_length_check(vw, out);
+
+    if (vw.is_contiguous() && out.is_contiguous())
+    {
+        vtool::_cast_range(vw.data(), out.data(), out.size());
+        return out;
+    }
+
+    vtool::parallel::for_each_range(out.size(), sizeof(U),
+        [=](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n) out[n] = static_cast<U>(vw[n]);
+        });
+    return out;
+}
+
+/* Syntax: vtool::vector_cast<value_type>(vtool::view vw);
+ * Return: std::vector with elements of "vw" casted to the specified value_type.
+ */
+template <typename To, typename From>
+std::vector<To>
+vector_cast(const vtool::view<From> vw)
+{
+    std::vector<To> cast_vec(vw.size());
+    vtool::vector_cast_into(vw, vtool::make_view(cast_vec));
+
+    return cast_vec;
+}
+
+/* Syntax: vtool::vector_cast_into(vtool::view vw, vtool::view out, [arithmetic_type scale,] conversion policy);
+ * Return: "out" holding the elements of "vw" times "scale" converted to its
+ *         value_type by "policy".
+ */
+template <typename T, typename U, typename S, typename Policy,
+          typename vtool::is_arithmetic<S>::type = true,
+          typename vtool::is_conversion<Policy>::type = true>
+vtool::view<U>
+vector_cast_into(const vtool::view<T> vw, const vtool::view<U> out,
+                 const S scale, const Policy policy)
+{
+    _vtool_length_check(vw, out);
+
+    if (vw.is_contiguous() && out.is_contiguous())
+    {
+        vtool::_cast_range(vw.data(), out.data(), out.size(), static_cast<VTOOL_DBL>(scale), policy);
+        return out;
+    }
+
+    using W = _cast_work_t<_view_value_t<T>, U>;
+    const W wscale = static_cast<W>(scale);
+
+    vtool::parallel::for_each_range(out.size(), sizeof(U),
+        [=](const std::size_t begin, const std::size_t end){
+            for (std::size_t n = begin; n < end; ++n)
+                out[n] = vtool::_cast_value<U>(static_cast<W>(vw[n]) * wscale, policy,
+                                               std::is_floating_point<U>());
+        });
+    return out;
+}
+
+template <typename T, typename U, typename Policy,
+          typename vtool::is_conversion<Policy>::type = true>
+inline vtool::view<U>
+vector_cast_into(const vtool::view<T> vw, const vtool::view<U> out, const Policy policy)
+{
+    return vtool::vector_cast_into(vw, out, 1, policy);
+}
+
+/* Syntax: vtool::vector_cast<value_type>(vtool::view vw, [arithmetic_type scale,] conversion policy);
+ * Return: std::vector with the elements of "vw" times "scale" converted to
+ *         the specified value_type by "policy".
+ */
+template <typename To, typename From, typename S, typename Policy,
+          typename vtool::is_arithmetic<S>::type = true,
+          typename vtool::is_conversion<Policy>::type = true>
+std::vector<To>
+vector_cast(const vtool::view<From> vw, const S scale, const Policy policy)
+{
+    std::vector<To> cast_vec(vw.size());
+    vtool::vector_cast_into(vw, vtool::make_view(cast_vec), scale, policy);
+
+    return cast_vec;
+}
+
+template <typename To, typename From, typename Policy,
+          typename vtool::is_conversion<Policy>::type = true>
+inline std::vector<To>
+vector_cast(const vtool::view<From> vw, const Policy policy)
+{
+    return vtool::vector_cast<To>(vw, 1, policy);
 }
 
 }   // namespace vtool
@@ -0,0 +1,250 @@
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o ----------------------------------- o
+    Non-owning Strided View of a Buffer
+  o ----------------------------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef __VTOOL_VIEW_H__
+#define __VTOOL_VIEW_H__
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <stdexcept>
+#include <iterator>
+#include <type_traits>
+
+namespace vtool {
+
+template <typename T>
+class view_iterator;
+
+// -------------------------------- view<T> ------------------------------- //
+/*
+ * Borrowed range of "size" elements starting at "data" and "stride" elements
+ * apart. A view never owns or reallocates its buffer, so sub-ranges, memory
+ * mapped regions and buffers handed over from Cython are processed in place.
+ * view<const T> is read-only, view<T> can also be written through. The
+ * stride may be negative but not zero, which would make begin() equal end().
+ */
+template <typename T>
+class view
+{
+    T* _data;
+    std::size_t _size;
+    std::ptrdiff_t _stride;
+
+  public:
+    using element_type   = T;
+    using value_type     = typename std::remove_cv<T>::type;
+    using allocator_type = std::allocator<value_type>;
+    using size_type      = std::size_t;
+    using reference      = T&;
+    using iterator       = view_iterator<T>;
+
+    _CXX20_CONSTEXPR
+    view(): _data(nullptr), _size(0), _stride(1) {}
+
+    _CXX20_CONSTEXPR
+    view(T* data, const std::size_t N, const std::ptrdiff_t stride=1)
+        : _data(data), _size(N), _stride(stride)
+    {
+        if (stride == 0)
+            throw std::domain_error("Invalid Stride: stride must be nonzero");
+    }
+
+    template <typename Alloc, typename U = T,
+              typename std::enable_if<std::is_const<U>::value, bool>::type = true>
+    _CXX20_CONSTEXPR
+    view(const std::vector<value_type, Alloc>& vec)
+        : _data(vec.data()), _size(vec.size()), _stride(1) {}
+
+    template <typename Alloc>
+    _CXX20_CONSTEXPR
+    view(std::vector<value_type, Alloc>& vec)
+        : _data(vec.data()), _size(vec.size()), _stride(1) {}
+
+    // view<T> converts to view<const T>
+    template <typename U,
+              typename std::enable_if<
+                  std::is_same<const U, T>::value && !std::is_same<U, T>::value, bool
+              >::type = true>
+    _CXX20_CONSTEXPR
+    view(const view<U>& other)
+        : _data(other.data()), _size(other.size()), _stride(other.stride()) {}
+
+    _CXX20_CONSTEXPR inline T*
+    data() const { return _data; }
+
+    _CXX20_CONSTEXPR inline std::size_t
+    size() const { return _size; }
+
+    _CXX20_CONSTEXPR inline std::ptrdiff_t
+    stride() const { return _stride; }
+
+    _CXX20_CONSTEXPR inline bool
+    empty() const { return _size == 0; }
+
+    _CXX20_CONSTEXPR inline bool
+    is_contiguous() const { return _stride == 1 || _size < 2; }
+
+    _CXX20_CONSTEXPR inline T&
+    operator[](const std::size_t n) const
+    { return _data[static_cast<std::ptrdiff_t>(n) * _stride]; }
+
+    _CXX20_CONSTEXPR inline iterator
+    begin() const { return iterator(_data, _stride); }
+
+    _CXX20_CONSTEXPR inline iterator
+    end() const { return iterator(_data + static_cast<std::ptrdiff_t>(_size) * _stride, _stride); }
+
+    /* Syntax: view.subview(std::size_t offset, std::size_t count, std::ptrdiff_t step=1);
+     * Return: vtool::view over every "step"-th of "count" elements from "offset".
+     *         A negative "step" walks back from "offset".
+     */
+    _CXX20_CONSTEXPR inline view
+    subview(const std::size_t offset, const std::size_t count,
+            const std::ptrdiff_t step=1) const
+    {
+        const std::size_t span = count ? (count - 1) * static_cast<std::size_t>(
+            step < 0 ? -step : step
+        ) : 0;
+
+        if (count ? offset >= _size || (step < 0 ? span > offset : span >= _size - offset)
+                  : offset > _size)
+            throw std::out_of_range("Invalid Range: subview exceeds the view");
+
+        return view(_data + static_cast<std::ptrdiff_t>(offset) * _stride, count, _stride * step);
+    }
+};
+
+// --------------------------- view_iterator<T> --------------------------- //
+template <typename T>
+class view_iterator
+{
+    T* _ptr;
+    std::ptrdiff_t _stride;
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = typename std::remove_cv<T>::type;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = T*;
+    using reference         = T&;
+
+    _CXX20_CONSTEXPR
+    view_iterator(): _ptr(nullptr), _stride(1) {}
+
+    _CXX20_CONSTEXPR
+    view_iterator(T* ptr, const std::ptrdiff_t stride)
+        : _ptr(ptr), _stride(stride) {}
+
+    _CXX20_CONSTEXPR inline reference
+    operator*() const { return *_ptr; }
+
+    _CXX20_CONSTEXPR inline pointer
+    operator->() const { return _ptr; }
+
+    _CXX20_CONSTEXPR inline reference
+    operator[](const difference_type n) const { return _ptr[n * _stride]; }
+
+    _CXX20_CONSTEXPR inline view_iterator&
+    operator++() { _ptr += _stride; return *this; }
+
+    _CXX20_CONSTEXPR inline view_iterator&
+    operator--() { _ptr -= _stride; return *this; }
+
+    _CXX20_CONSTEXPR inline view_iterator
+    operator++(int) { view_iterator it(*this); _ptr += _stride; return it; }
+
+    _CXX20_CONSTEXPR inline view_iterator
+    operator--(int) { view_iterator it(*this); _ptr -= _stride; return it; }
+
+    _CXX20_CONSTEXPR inline view_iterator&
+    operator+=(const difference_type n) { _ptr += n * _stride; return *this; }
+
+    _CXX20_CONSTEXPR inline view_iterator&
+    operator-=(const difference_type n) { _ptr -= n * _stride; return *this; }
+
+    _CXX20_CONSTEXPR inline view_iterator
+    operator+(const difference_type n) const { return view_iterator(_ptr + n * _stride, _stride); }
+
+    _CXX20_CONSTEXPR inline view_iterator
+    operator-(const difference_type n) const { return view_iterator(_ptr - n * _stride, _stride); }
+
+    _CXX20_CONSTEXPR inline difference_type
+    operator-(const view_iterator& other) const { return (_ptr - other._ptr) / _stride; }
+
+    _CXX20_CONSTEXPR inline bool
+    operator==(const view_iterator& other) const { return _ptr == other._ptr; }
+
+    _CXX20_CONSTEXPR inline bool
+    operator!=(const view_iterator& other) const { return _ptr != other._ptr; }
+
+    _CXX20_CONSTEXPR inline bool
+    operator<(const view_iterator& other) const { return (other - *this) > 0; }
+
+    _CXX20_CONSTEXPR inline bool
+    operator>(const view_iterator& other) const { return (*this - other) > 0; }
+
+    _CXX20_CONSTEXPR inline bool
+    operator<=(const view_iterator& other) const { return !(*this > other); }
+
+    _CXX20_CONSTEXPR inline bool
+    operator>=(const view_iterator& other) const { return !(*this < other); }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+/*
+  o -------------- o
+    View Functions
+  o -------------- o
+*/
+//////////////////////////////////////////////////////////////////////////////
+
+/* Syntax: vtool::make_view(pointer data, std::size_t N, std::ptrdiff_t stride=1);
+ * Return: vtool::view over "N" elements of "data", "stride" elements apart.
+ */
+template <typename T>
+_CXX20_CONSTEXPR
+inline view<T>
+make_view(T* data, const std::size_t N, const std::ptrdiff_t stride=1)
+{
+    return view<T>(data, N, stride);
+}
+
+/* Syntax: vtool::make_view(std::vector vec);
+ * Return: vtool::view over every element of "vec", writable unless "vec" is const.
+ */
+template <typename T, typename Alloc>
+_CXX20_CONSTEXPR
+inline view<T>
+make_view(std::vector<T, Alloc>& vec)
+{
+    return view<T>(vec);
+}
+
+template <typename T, typename Alloc>
+_CXX20_CONSTEXPR
+inline view<const T>
+make_view(const std::vector<T, Alloc>& vec)
+{
+    return view<const T>(vec);
+}
+
+/* Syntax: vtool::to_vector(vtool::view vw);
+ * Return: std::vector holding a copy of the elements of "vw".
+ */
+template <typename T>
+_CXX20_CONSTEXPR
+inline std::vector<typename view<T>::value_type>
+to_vector(const view<T> vw)
+{
+    return std::vector<typename view<T>::value_type>(vw.begin(), vw.end());
+}
+
+}   // namespace vtool
+
+#endif  // __VTOOL_VIEW_H__
@@ -12,6 +12,8 @@
 
 #include <cmath>
 #include <vector>
+#include <cstddef>
+#include <stdexcept>
 
 namespace vtool {
     namespace windows {
@@ -35,7 +37,7 @@ namespace vtool {
     }
 
 #define _typed_div(T, L, R) \
-    (static_cast<T>(L) / R)
+    (static_cast<T>(L) / (R))
 
 #define _n_domain(T, n, m)  \
     (_c::pi * _typed_div(T, n, m))
@@ -81,7 +83,7 @@ _win(const std::size_t N)                           \
 }
 
 //////////////////////////////////////////////////////////////////////////////
-// -------------------------- window functions ---------------------------- //
+// --------------------------- window functions --------------------------- //
     _WINDOWS_FUNCTION(sine)
     _WINDOWS_FUNCTION(hanning)
     _WINDOWS_FUNCTION(hamming)
@@ -89,6 +91,49 @@ _win(const std::size_t N)                           \
     _WINDOWS_FUNCTION(barthann)
     _WINDOWS_FUNCTION(blackman)
 
+// ------------------------------ window type ----------------------------- //
+    // window selectable at run time by vtool::windows::make() and vtool::stft_plan
+    enum class type: unsigned
+    {
+        rectangular,
+        sine,
+        hanning,
+        hamming,
+        bartlett,
+        barthann,
+        blackman
+    };
+
+    /* Syntax: vtool::windows::make<T>(vtool::windows::type win, std::size_t N,
+     *                                 bool periodic=false);
+     * Return: std::vector holding the "N" points of window "win". A periodic
+     *         window is the symmetric one of N+1 points without its last point,
+     *         as used for spectral analysis.
+     */
+    template <typename T = double,
+              typename Alloc = std::allocator<T>>
+    std::vector<T, Alloc>
+    make(const type win, const std::size_t N, const bool periodic=false)
+    {
+        const std::size_t M = N + (periodic && N > 0 ? 1 : 0);
+        std::vector<T, Alloc> win_vec;
+
+        switch (win)
+        {
+            case type::rectangular: win_vec.assign(M, 1); break;
+            case type::sine:        win_vec = sine<T, Alloc>(M);     break;
+            case type::hanning:     win_vec = hanning<T, Alloc>(M);  break;
+            case type::hamming:     win_vec = hamming<T, Alloc>(M);  break;
+            case type::bartlett:    win_vec = bartlett<T, Alloc>(M); break;
+            case type::barthann:    win_vec = barthann<T, Alloc>(M); break;
+            case type::blackman:    win_vec = blackman<T, Alloc>(M); break;
+            default:
+                throw std::invalid_argument("Invalid Window: unknown window type");
+        }
+        win_vec.resize(N);
+        return win_vec;
+    }
+
     }   // namespace windows
 }   // namespace vtool
 